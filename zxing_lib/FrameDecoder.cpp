@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2017 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "FrameDecoder.h"
+
+FrameDecoder::FrameDecoder(int width_, int height_, int stride_, ImageReaderSource::PixelFormat format_,
+                           DecodeHints const& hints)
+    : width(width_), height(height_), stride(stride_), format(format_),
+      luminances(width_ * height_), reader(new MultiFormatReader) {
+  if (stride < width * ImageReaderSource::bytesPerPixel(format)) {
+    throw zxing::IllegalArgumentException("Frame stride is smaller than a row of pixels.");
+  }
+  reader->setHints(hints);
+
+  // Both binarizers read the same plane, which decode() refills in place.
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(luminances, width, height, 0, 0, width, height));
+  hybridBitmap = new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(source)));
+  if (hints.getBinarizerWindowSize() > 0) {
+    fallbackBitmap = new BinaryBitmap(Ref<Binarizer>(new IntegralImageBinarizer(source, hints)));
+  } else {
+    fallbackBitmap = new BinaryBitmap(Ref<Binarizer>(new GlobalHistogramBinarizer(source)));
+  }
+}
+
+namespace {
+  // Rebuilds a result's points on the heap so it survives an arena reset.
+  Ref<Result> detachResult(Ref<Result> const& result) {
+    ArrayRef< Ref<ResultPoint> > points = result->getResultPoints();
+    ArrayRef< Ref<ResultPoint> > copies(points->size());
+    for (int i = 0; i < points->size(); i++) {
+      copies[i] = new ResultPoint(points[i]->getX(), points[i]->getY());
+    }
+    return Ref<Result>(new Result(result->getText(), result->getRawBytes(), copies,
+                                  result->getBarcodeFormat()));
+  }
+}
+
+int FrameDecoder::decodeBitmap(Ref<BinaryBitmap> bitmap, vector<Ref<Result> > * results) {
+  int status = -1;
+  try {
+    Ref<Result> result;
+    {
+      zxing::Arena::Scope scope(arena);
+      result = reader->decodeWithState(bitmap);
+    }
+    *results = vector<Ref<Result> >(1, detachResult(result));
+    status = 0;
+  } catch (const zxing::Exception& e) {
+    (void)e;
+  } catch (const std::exception& e) {
+    (void)e;
+  }
+  // Every object of the decode has been released by now.
+  arena.reset();
+  return status;
+}
+
+int FrameDecoder::decode(const uint8_t* frame, vector<Ref<Result> > * results) {
+  ImageReaderSource::convertFrame((const char*)frame, width, height, stride, format, &luminances[0]);
+  hybridBitmap->reset();
+  fallbackBitmap->reset();
+
+  if (decodeBitmap(hybridBitmap, results) == 0) {
+    return 0;
+  }
+  return decodeBitmap(fallbackBitmap, results);
+}
@@ -0,0 +1,67 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __FRAME_DECODER_H_
+#define __FRAME_DECODER_H_
+/*
+ *  Copyright 2017 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImageReaderSource.h"
+#include <zxing/common/Arena.h>
+
+/**
+ * Decodes a stream of same-sized camera frames.
+ *
+ * The readers, the luminance plane, the binarizers' black point grid and
+ * bit matrix are allocated once for the stream resolution and refilled
+ * for every frame, so decoding does not churn the heap with frame-sized
+ * buffers. The short-lived detector and decoder objects of each attempt
+ * are placed in an arena that is rewound afterwards; returned results are
+ * copied out of it.
+ *
+ * Like ex_decode(), each frame is tried with the hybrid binarizer first
+ * and the global histogram binarizer second. When the hints set a
+ * binarizer window size, the second pass uses an IntegralImageBinarizer
+ * of that size instead, which copes better with uneven lighting.
+ */
+class FrameDecoder {
+private:
+  const int width;
+  const int height;
+  const int stride;
+  const ImageReaderSource::PixelFormat format;
+
+  zxing::ArrayRef<char> luminances;
+  zxing::Ref<zxing::MultiFormatReader> reader;
+  zxing::Ref<zxing::BinaryBitmap> hybridBitmap;
+  zxing::Ref<zxing::BinaryBitmap> fallbackBitmap;
+  zxing::Arena arena;
+
+  int decodeBitmap(zxing::Ref<zxing::BinaryBitmap> bitmap, vector<Ref<Result> > * results);
+
+  FrameDecoder(const FrameDecoder&);
+  FrameDecoder& operator =(const FrameDecoder&);
+
+public:
+  FrameDecoder(int width, int height, int stride, ImageReaderSource::PixelFormat format,
+               DecodeHints const& hints = DecodeHints::DEFAULT_HINT);
+
+  /**
+   * Decodes one frame laid out as given to the constructor. Returns 0 and
+   * fills results when a code was found, -1 otherwise.
+   */
+  int decode(const uint8_t* frame, vector<Ref<Result> > * results);
+};
+
+#endif /* __FRAME_DECODER_H_ */
@@ -23,25 +23,283 @@
 #include <fstream>
 #include <string>
 
+/*
+ * Whole-row luminance kernels for the RGB and YCbCr formats. The vector paths are picked at build time
+ * from the target flags (-mfpu=neon, -msse2, -mavx2); define
+ * ZXING_NO_SIMD to force the scalar path. Every path computes
+ * (306 * R + 601 * G + 117 * B + 0x200) >> 10, the same as convertPixel().
+ */
+#if !defined(ZXING_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ZXING_LUMA_NEON 1
+#include <arm_neon.h>
+#elif !defined(ZXING_NO_SIMD) && defined(__AVX2__)
+#define ZXING_LUMA_AVX2 1
+#include <immintrin.h>
+#elif !defined(ZXING_NO_SIMD) && defined(__SSE2__)
+#define ZXING_LUMA_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+#if defined(ZXING_LUMA_NEON)
+
+// Returns the number of pixels converted; the caller finishes the tail.
+int convertRowRGBA(const unsigned char* pixels, unsigned char* luma, int count) {
+  int x = 0;
+  for (; x + 8 <= count; x += 8) {
+    uint8x8x4_t p = vld4_u8(pixels + 4 * x);
+    uint16x8_t r = vmovl_u8(p.val[0]);
+    uint16x8_t g = vmovl_u8(p.val[1]);
+    uint16x8_t b = vmovl_u8(p.val[2]);
+    uint32x4_t lo = vmull_n_u16(vget_low_u16(r), 306);
+    lo = vmlal_n_u16(lo, vget_low_u16(g), 601);
+    lo = vmlal_n_u16(lo, vget_low_u16(b), 117);
+    uint32x4_t hi = vmull_n_u16(vget_high_u16(r), 306);
+    hi = vmlal_n_u16(hi, vget_high_u16(g), 601);
+    hi = vmlal_n_u16(hi, vget_high_u16(b), 117);
+    // vrshrn adds 1 << 9 before shifting, which is the 0x200 rounding term
+    uint16x8_t y = vcombine_u16(vrshrn_n_u32(lo, 10), vrshrn_n_u32(hi, 10));
+    vst1_u8(luma + x, vmovn_u16(y));
+  }
+  return x;
+}
+
+int convertRowRGB(const unsigned char* pixels, unsigned char* luma, int count) {
+  int x = 0;
+  for (; x + 8 <= count; x += 8) {
+    uint8x8x3_t p = vld3_u8(pixels + 3 * x);
+    uint16x8_t r = vmovl_u8(p.val[0]);
+    uint16x8_t g = vmovl_u8(p.val[1]);
+    uint16x8_t b = vmovl_u8(p.val[2]);
+    uint32x4_t lo = vmull_n_u16(vget_low_u16(r), 306);
+    lo = vmlal_n_u16(lo, vget_low_u16(g), 601);
+    lo = vmlal_n_u16(lo, vget_low_u16(b), 117);
+    uint32x4_t hi = vmull_n_u16(vget_high_u16(r), 306);
+    hi = vmlal_n_u16(hi, vget_high_u16(g), 601);
+    hi = vmlal_n_u16(hi, vget_high_u16(b), 117);
+    uint16x8_t y = vcombine_u16(vrshrn_n_u32(lo, 10), vrshrn_n_u32(hi, 10));
+    vst1_u8(luma + x, vmovn_u16(y));
+  }
+  return x;
+}
+
+// Copies the Y byte out of each 2-byte YCbCr 4:2:2 pixel; yOffset is 0 for YUYV, 1 for UYVY.
+int convertRowYCbCr422(const unsigned char* pixels, unsigned char* luma, int count, int yOffset) {
+  int x = 0;
+  for (; x + 16 <= count; x += 16) {
+    uint8x16x2_t p = vld2q_u8(pixels + 2 * x);
+    vst1q_u8(luma + x, yOffset ? p.val[1] : p.val[0]);
+  }
+  return x;
+}
+
+#elif defined(ZXING_LUMA_AVX2) || defined(ZXING_LUMA_SSE2)
+
+// Luma of four pixels, one per 32-bit lane of p as R, G, B and an ignored
+// fourth byte, left unpacked in the 32-bit lanes.
+inline __m128i convert4(__m128i p) {
+  const __m128i weights = _mm_setr_epi16(306, 601, 117, 0, 306, 601, 117, 0);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i half = _mm_set1_epi32(0x200);
+  // lo holds pixels 0,1 and hi pixels 2,3 as (306R + 601G, 117B) pairs.
+  __m128 lo = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpacklo_epi8(p, zero), weights));
+  __m128 hi = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpackhi_epi8(p, zero), weights));
+  __m128i even = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+  __m128i odd = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+  return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(even, odd), half), 10);
+}
+
+#if defined(ZXING_LUMA_AVX2)
+
+int convertRowRGBA(const unsigned char* pixels, unsigned char* luma, int count) {
+  const __m256i weights = _mm256_setr_epi16(306, 601, 117, 0, 306, 601, 117, 0,
+                                            306, 601, 117, 0, 306, 601, 117, 0);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i half = _mm256_set1_epi32(0x200);
+  int x = 0;
+  for (; x + 16 <= count; x += 16) {
+    __m256i sums[2];
+    for (int k = 0; k < 2; k++) {
+      __m256i p = _mm256_loadu_si256((const __m256i*)(pixels + 4 * (x + 8 * k)));
+      // Per 128-bit lane: lo holds pixels 0,1 and hi pixels 2,3 as
+      // (306R + 601G, 117B) pairs.
+      __m256 lo = _mm256_castsi256_ps(_mm256_madd_epi16(_mm256_unpacklo_epi8(p, zero), weights));
+      __m256 hi = _mm256_castsi256_ps(_mm256_madd_epi16(_mm256_unpackhi_epi8(p, zero), weights));
+      __m256i even = _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+      __m256i odd = _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+      sums[k] = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(even, odd), half), 10);
+    }
+    __m256i y16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(sums[0], sums[1]),
+                                           _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i y8 = _mm_packus_epi16(_mm256_castsi256_si128(y16), _mm256_extracti128_si256(y16, 1));
+    _mm_storeu_si128((__m128i*)(luma + x), y8);
+  }
+  return x;
+}
+
+#else
+
+int convertRowRGBA(const unsigned char* pixels, unsigned char* luma, int count) {
+  int x = 0;
+  for (; x + 16 <= count; x += 16) {
+    __m128i sums[4];
+    for (int k = 0; k < 4; k++) {
+      sums[k] = convert4(_mm_loadu_si128((const __m128i*)(pixels + 4 * (x + 4 * k))));
+    }
+    __m128i y8 = _mm_packus_epi16(_mm_packs_epi32(sums[0], sums[1]),
+                                  _mm_packs_epi32(sums[2], sums[3]));
+    _mm_storeu_si128((__m128i*)(luma + x), y8);
+  }
+  return x;
+}
+
+#endif
+
+/*
+ * Four RGB pixels at a time, spread from the low 12 bytes of a load to one
+ * per 32-bit lane and then weighted like RGBA. AVX2 builds use this as well.
+ */
+int convertRowRGB(const unsigned char* pixels, unsigned char* luma, int count) {
+  const __m128i lane0 = _mm_setr_epi32(-1, 0, 0, 0);
+  const __m128i lane1 = _mm_setr_epi32(0, -1, 0, 0);
+  const __m128i lane2 = _mm_setr_epi32(0, 0, -1, 0);
+  const __m128i lane3 = _mm_setr_epi32(0, 0, 0, -1);
+  int x = 0;
+  // Each load reads 4 bytes past its pixels, so stop while the last load of
+  // the block still ends inside the row.
+  for (; 3 * x + 52 <= 3 * count; x += 16) {
+    __m128i sums[4];
+    for (int k = 0; k < 4; k++) {
+      __m128i p = _mm_loadu_si128((const __m128i*)(pixels + 3 * (x + 4 * k)));
+      // Pixel i starts at byte 3i; shifting left by i bytes moves it to 4i.
+      __m128i rgbx = _mm_or_si128(_mm_or_si128(_mm_and_si128(p, lane0),
+                                               _mm_and_si128(_mm_slli_si128(p, 1), lane1)),
+                                  _mm_or_si128(_mm_and_si128(_mm_slli_si128(p, 2), lane2),
+                                               _mm_and_si128(_mm_slli_si128(p, 3), lane3)));
+      sums[k] = convert4(rgbx);
+    }
+    __m128i y8 = _mm_packus_epi16(_mm_packs_epi32(sums[0], sums[1]),
+                                  _mm_packs_epi32(sums[2], sums[3]));
+    _mm_storeu_si128((__m128i*)(luma + x), y8);
+  }
+  return x;
+}
+
+int convertRowYCbCr422(const unsigned char* pixels, unsigned char* luma, int count, int yOffset) {
+  const __m128i mask = _mm_set1_epi16(0x00FF);
+  int x = 0;
+  for (; x + 16 <= count; x += 16) {
+    __m128i a = _mm_loadu_si128((const __m128i*)(pixels + 2 * x));
+    __m128i b = _mm_loadu_si128((const __m128i*)(pixels + 2 * x + 16));
+    if (yOffset) {
+      a = _mm_srli_epi16(a, 8);
+      b = _mm_srli_epi16(b, 8);
+    } else {
+      a = _mm_and_si128(a, mask);
+      b = _mm_and_si128(b, mask);
+    }
+    _mm_storeu_si128((__m128i*)(luma + x), _mm_packus_epi16(a, b));
+  }
+  return x;
+}
+
+#else
 
-inline char ImageReaderSource::convertPixel(char const* pixel_) const {
+int convertRowRGBA(const unsigned char*, unsigned char*, int) {
+  return 0;
+}
+
+int convertRowRGB(const unsigned char*, unsigned char*, int) {
+  return 0;
+}
+
+int convertRowYCbCr422(const unsigned char*, unsigned char*, int, int) {
+  return 0;
+}
+
+#endif
+
+}
+
+inline char ImageReaderSource::convertPixel(PixelFormat format, char const* pixel_) {
   unsigned char const* pixel = (unsigned char const*)pixel_;
-  if (comps == 1 || comps == 2) {
-    // Gray or gray+alpha
+  switch (format) {
+  case GRAY8:
+  case GRAY_ALPHA:
+  case NV12:
+  case YUYV:
+    // Gray, or the Y byte that leads a YUYV pair
     return pixel[0];
-  } if (comps == 3 || comps == 4) {
+  case UYVY:
+    return pixel[1];
+  case RGB565: {
+    // Expand each channel to 8 bits, then weight it like RGB888
+    int value = pixel[0] | (pixel[1] << 8);
+    int r = (value >> 11) & 0x1F;
+    int g = (value >> 5) & 0x3F;
+    int b = value & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return (char)((306 * r + 601 * g + 117 * b + 0x200) >> 10);
+  }
+  case RGB888:
+  case RGBA8888:
     // Red, Green, Blue, (Alpha)
     // We assume 16 bit values here
     // 0x200 = 1<<9, half an lsb of the result to force rounding
     return (char)((306 * (int)pixel[0] + 601 * (int)pixel[1] +
         117 * (int)pixel[2] + 0x200) >> 10);
-  } else {
+  default:
     throw zxing::IllegalArgumentException("Unexpected image depth");
   }
 }
 
+int ImageReaderSource::bytesPerPixel(PixelFormat format) {
+  switch (format) {
+  case GRAY8:
+  case NV12:
+    return 1;
+  case GRAY_ALPHA:
+  case YUYV:
+  case UYVY:
+  case RGB565:
+    return 2;
+  case RGB888:
+    return 3;
+  case RGBA8888:
+    return 4;
+  default:
+    throw zxing::IllegalArgumentException("Unexpected pixel format");
+  }
+}
+
+namespace {
+  ImageReaderSource::PixelFormat formatForComps(int comps) {
+    switch (comps) {
+    case 1:
+      return ImageReaderSource::GRAY8;
+    case 2:
+      return ImageReaderSource::GRAY_ALPHA;
+    case 3:
+      return ImageReaderSource::RGB888;
+    case 4:
+      return ImageReaderSource::RGBA8888;
+    default:
+      throw zxing::IllegalArgumentException("Unexpected image depth");
+    }
+  }
+}
+
 ImageReaderSource::ImageReaderSource(ArrayRef<char> image_, int width, int height, int comps_)
-    : Super(width, height), image(image_), comps(comps_) {}
+    : Super(width, height), image(image_), pixels(&image_[0]), stride(width * comps_),
+      format(formatForComps(comps_)) {}
+
+ImageReaderSource::ImageReaderSource(const char* pixels_, int width, int height, int stride_,
+                                     PixelFormat format_)
+    : Super(width, height), pixels(pixels_), stride(stride_),
+      format(format_) {}
 
 Ref<LuminanceSource> ImageReaderSource::create(char* buf, int buf_size, int width, int height) {
     int comps = 4;
@@ -60,30 +318,80 @@ Ref<LuminanceSource> ImageReaderSource::create(char* buf, int buf_size, int widt
     return Ref<LuminanceSource>(new ImageReaderSource(image, width, height, comps));
 }
 
+Ref<LuminanceSource> ImageReaderSource::wrap(const char* buf, int width, int height, int stride) {
+    return wrap(buf, width, height, stride, RGBA8888);
+}
+
+Ref<LuminanceSource> ImageReaderSource::wrap(const char* buf, int width, int height, int stride,
+                                             PixelFormat format) {
+    if (buf == NULL) {
+        throw zxing::IllegalArgumentException("Frame buffer is NULL.");
+    }
+    if (stride < width * bytesPerPixel(format)) {
+        throw zxing::IllegalArgumentException("Frame stride is smaller than a row of pixels.");
+    }
+
+    return Ref<LuminanceSource>(new ImageReaderSource(buf, width, height, stride, format));
+}
+
+void ImageReaderSource::convertRow(PixelFormat format, const char* pixelRow, char* luma, int count) {
+  const int comps = bytesPerPixel(format);
+  const unsigned char* p = (const unsigned char*)pixelRow;
+  unsigned char* l = (unsigned char*)luma;
+  int x = 0;
+  switch (format) {
+  case GRAY8:
+  case NV12:
+    memcpy(luma, pixelRow, count);
+    return;
+  case GRAY_ALPHA:
+  case YUYV:
+    // The gray byte leads each GRAY_ALPHA pair, as Y does in YUYV.
+    x = convertRowYCbCr422(p, l, count, 0);
+    break;
+  case UYVY:
+    x = convertRowYCbCr422(p, l, count, 1);
+    break;
+  case RGB888:
+    x = convertRowRGB(p, l, count);
+    break;
+  case RGBA8888:
+    x = convertRowRGBA(p, l, count);
+    break;
+  default:
+    break;
+  }
+  for (; x < count; x++) {
+    luma[x] = convertPixel(format, pixelRow + (x * comps));
+  }
+}
+
 zxing::ArrayRef<char> ImageReaderSource::getRow(int y, zxing::ArrayRef<char> row) const {
-  const char* pixelRow = &image[0] + y * getWidth() * 4;
+  const char* pixelRow = pixels + y * stride;
   if (!row) {
     row = zxing::ArrayRef<char>(getWidth());
   }
-  for (int x = 0; x < getWidth(); x++) {
-    row[x] = convertPixel(pixelRow + (x * 4));
-  }
+  convertRow(format, pixelRow, &row[0], getWidth());
   return row;
 }
 
 /** This is a more efficient implementation. */
 zxing::ArrayRef<char> ImageReaderSource::getMatrix() const {
-  const char* p = &image[0];
   zxing::ArrayRef<char> matrix(getWidth() * getHeight());
-  char* m = &matrix[0];
-  for (int y = 0; y < getHeight(); y++) {
-    for (int x = 0; x < getWidth(); x++) {
-      *m = convertPixel(p);
-      m++;
-      p += 4;
+  convertFrame(pixels, getWidth(), getHeight(), stride, format, &matrix[0]);
+  return matrix;
+}
+
+void ImageReaderSource::convertFrame(const char* buf, int width, int height, int stride,
+                                     PixelFormat format, char* luma) {
+  if (stride == width * bytesPerPixel(format)) {
+    // No padding between rows, so the frame is one long row.
+    convertRow(format, buf, luma, width * height);
+  } else {
+    for (int y = 0; y < height; y++) {
+      convertRow(format, buf + y * stride, luma + y * width, width);
     }
   }
-  return matrix;
 }
 
 vector<Ref<Result> > decode(Ref<BinaryBitmap> image, DecodeHints hints) {
@@ -134,18 +442,28 @@ int decode_image(Ref<LuminanceSource> source, bool hybrid, vector<Ref<Result> >
     return res;
 }
 
-int ex_decode(uint8_t* buf, int buf_size, int width, int height, vector<Ref<Result> > * results) {
+int ex_decode(uint8_t* buf, int buf_size, int width, int height, int stride,
+              ImageReaderSource::PixelFormat format, vector<Ref<Result> > * results) {
     int h_result = 1;
     int g_result = 1;
     int result = 0;
     Ref<LuminanceSource> source;
 
+    if (stride * height > buf_size) {
+        return -1;
+    }
     try {
-        source = ImageReaderSource::create((char*)buf, buf_size, width, height);
+        // The frame buffer is not rewritten while it is being decoded, so it can be read in place.
+        source = ImageReaderSource::wrap((const char*)buf, width, height, stride, format);
     } catch (const zxing::IllegalArgumentException &e) {
         cerr << e.what() << " (ignoring)" << endl;
+        return -1;
     }
 
+    // Convert to luminance once; the hybrid and the global histogram passes
+    // (and any crop or rotation they make) all read the same plane.
+    source = new GreyscaleLuminanceSource(source->getMatrix(), width, height, 0, 0, width, height);
+
     h_result = decode_image(source, true, results);
     if (h_result != 0) {
         g_result = decode_image(source, false, results);
@@ -29,6 +29,8 @@
 #include <zxing/ReaderException.h>
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/IntegralImageBinarizer.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
 #include <exception>
 #include <zxing/Exception.h>
 #include <zxing/common/IllegalArgumentException.h>
@@ -54,24 +56,59 @@ using namespace zxing::qrcode;
 
 
 class ImageReaderSource : public zxing::LuminanceSource {
+public:
+  /** Memory layouts of the frames a source can read luminance from. */
+  enum PixelFormat {
+    GRAY8,      // 8-bit luminance
+    GRAY_ALPHA, // 8-bit luminance and an ignored alpha byte
+    NV12,       // YCbCr 4:2:0; only the leading Y plane is read
+    YUYV,       // YCbCr 4:2:2 packed as Y0 Cb Y1 Cr
+    UYVY,       // YCbCr 4:2:2 packed as Cb Y0 Cr Y1
+    RGB565,     // little-endian 16-bit, red in the top bits
+    RGB888,     // R, G, B bytes
+    RGBA8888    // R, G, B bytes and an ignored fourth byte
+  };
+
 private:
   typedef LuminanceSource Super;
 
+  // Owned copy of the pixels; empty when the source borrows the caller's frame.
   const zxing::ArrayRef<char> image;
-  const int comps;
+  const char* const pixels;
+  const int stride;
+  const PixelFormat format;
 
-  char convertPixel(const char* pixel) const;
+  static char convertPixel(PixelFormat format, const char* pixel);
+  static void convertRow(PixelFormat format, const char* pixelRow, char* luma, int count);
 
 public:
   static zxing::Ref<LuminanceSource> create(char* buf, int buf_size, int width, int height);
 
+  /**
+   * Wraps a frame without copying it. stride is the distance in bytes
+   * between the starts of consecutive rows. The caller must keep buf valid
+   * and unmodified until the source, and every binarizer and bitmap built
+   * on it, has been released. Without a format the frame is RGBA8888.
+   */
+  static zxing::Ref<LuminanceSource> wrap(const char* buf, int width, int height, int stride);
+  static zxing::Ref<LuminanceSource> wrap(const char* buf, int width, int height, int stride,
+                                          PixelFormat format);
+
+  static int bytesPerPixel(PixelFormat format);
+
+  /** Converts a whole frame into luma, a width * height luminance plane. */
+  static void convertFrame(const char* buf, int width, int height, int stride,
+                           PixelFormat format, char* luma);
+
   ImageReaderSource(zxing::ArrayRef<char> image, int width, int height, int comps);
+  ImageReaderSource(const char* pixels, int width, int height, int stride, PixelFormat format);
 
   zxing::ArrayRef<char> getRow(int y, zxing::ArrayRef<char> row) const;
   zxing::ArrayRef<char> getMatrix() const;
 };
 
-extern int ex_decode(uint8_t* buf, int buf_size, int width, int height, vector<Ref<Result> > * results);
+extern int ex_decode(uint8_t* buf, int buf_size, int width, int height, int stride,
+                     ImageReaderSource::PixelFormat format, vector<Ref<Result> > * results);
 
 
 #endif /* __IMAGE_READER_SOURCE_H_ */
@@ -0,0 +1,237 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DecodeBench.cpp
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Times whole-frame decodes and counts the exceptions thrown per decode.
+ *
+ *   DecodeBench [-n iterations] [frame.pgm ...]
+ *
+ * Each frame goes through a fresh GreyscaleLuminanceSource, HybridBinarizer
+ * and BinaryBitmap into MultiFormatReader with the default hints, the way
+ * ex_decode() reads a camera frame. Besides any 8-bit binary PGM files given,
+ * two 640x480 frames are made here: one without a code, which is what most
+ * camera frames are, and one holding a Code 39 symbol. Only the public API is
+ * used, so the same source builds against older trees for a before and after
+ * comparison; see the Makefile.
+ *
+ * Throws are counted by wrapping __cxa_throw at link time, which needs GNU
+ * ld and the Itanium C++ ABI.
+ */
+
+#include <zxing/MultiFormatReader.h>
+#include <zxing/BinaryBitmap.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/Result.h>
+#include <zxing/Exception.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+using zxing::Ref;
+using zxing::ArrayRef;
+using zxing::Binarizer;
+using zxing::BinaryBitmap;
+using zxing::DecodeHints;
+using zxing::GreyscaleLuminanceSource;
+using zxing::HybridBinarizer;
+using zxing::LuminanceSource;
+using zxing::MultiFormatReader;
+using zxing::Result;
+
+namespace {
+  long throws = 0;
+}
+
+extern "C" {
+  void __real___cxa_throw(void* exception, void* type, void (*destructor)(void*))
+    __attribute__((noreturn));
+
+  void __wrap___cxa_throw(void* exception, void* type, void (*destructor)(void*))
+    __attribute__((noreturn));
+
+  void __wrap___cxa_throw(void* exception, void* type, void (*destructor)(void*)) {
+    throws++;
+    __real___cxa_throw(exception, type, destructor);
+  }
+}
+
+namespace {
+  const int WIDTH = 640;
+  const int HEIGHT = 480;
+
+  struct Frame {
+    string name;
+    int width;
+    int height;
+    vector<char> pixels;
+  };
+
+  // A small LCG, so that every run sees the same noise.
+  class Random {
+  private:
+    unsigned state_;
+  public:
+    explicit Random(unsigned seed) : state_(seed) {}
+    int next(int bound) {
+      state_ = state_ * 1103515245u + 12345u;
+      return (int)((state_ >> 8) % (unsigned)bound);
+    }
+  };
+
+  void addNoise(Frame& frame, int amplitude, unsigned seed) {
+    Random random(seed);
+    for (size_t i = 0; i < frame.pixels.size(); i++) {
+      int value = (unsigned char)frame.pixels[i] + random.next(2 * amplitude + 1) - amplitude;
+      frame.pixels[i] = (char)(value < 0 ? 0 : value > 255 ? 255 : value);
+    }
+  }
+
+  Frame blankFrame() {
+    Frame frame;
+    frame.name = "blank";
+    frame.width = WIDTH;
+    frame.height = HEIGHT;
+    frame.pixels.assign(WIDTH * HEIGHT, (char)220);
+    // Sensor noise wider than the binarizer's dynamic range threshold, so
+    // the frame binarizes to speckle that the readers must rule out.
+    addNoise(frame, 20, 1);
+    return frame;
+  }
+
+  // Wide/narrow patterns, one bit per element from the first bar, 1 = wide.
+  int code39Pattern(char c) {
+    static const char ALPHABET[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-. *";
+    static const int PATTERNS[] = {
+      0x034, 0x121, 0x061, 0x160, 0x031, 0x130, 0x070, 0x025, 0x124, 0x064,
+      0x109, 0x049, 0x148, 0x019, 0x118, 0x058, 0x00D, 0x10C, 0x04C, 0x01C,
+      0x103, 0x043, 0x142, 0x013, 0x112, 0x052, 0x007, 0x106, 0x046, 0x016,
+      0x181, 0x0C1, 0x1C0, 0x091, 0x190, 0x0D0, 0x085, 0x184, 0x0C4, 0x094
+    };
+    return PATTERNS[strchr(ALPHABET, c) - ALPHABET];
+  }
+
+  Frame code39Frame(string const& text) {
+    const int narrow = 3;
+    const int wide = 7;
+    string symbol = "*" + text + "*";
+    vector<bool> modules;
+    for (size_t i = 0; i < symbol.size(); i++) {
+      int pattern = code39Pattern(symbol[i]);
+      for (int element = 0; element < 9; element++) {
+        int width = (pattern >> (8 - element)) & 1 ? wide : narrow;
+        modules.insert(modules.end(), width, element % 2 == 0);
+      }
+      modules.insert(modules.end(), narrow, false);
+    }
+    Frame frame;
+    frame.name = "code39";
+    frame.width = WIDTH;
+    frame.height = HEIGHT;
+    frame.pixels.assign(WIDTH * HEIGHT, (char)210);
+    int left = (WIDTH - (int)modules.size()) / 2;
+    for (int y = HEIGHT / 4; y < HEIGHT * 3 / 4; y++) {
+      for (size_t x = 0; x < modules.size(); x++) {
+        if (modules[x]) {
+          frame.pixels[y * WIDTH + left + x] = (char)40;
+        }
+      }
+    }
+    addNoise(frame, 10, 2);
+    return frame;
+  }
+
+  bool readPgm(const char* path, Frame& frame) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+      return false;
+    }
+    int maxValue = 0;
+    bool ok = fscanf(file, "P5 %d %d %d", &frame.width, &frame.height, &maxValue) == 3 &&
+      maxValue == 255 && fgetc(file) != EOF;
+    if (ok) {
+      frame.pixels.resize(frame.width * frame.height);
+      ok = fread(&frame.pixels[0], 1, frame.pixels.size(), file) == frame.pixels.size();
+    }
+    fclose(file);
+    frame.name = path;
+    return ok;
+  }
+
+  string decode(Frame const& frame, MultiFormatReader& reader, DecodeHints const& hints) {
+    ArrayRef<char> luminances(frame.width * frame.height);
+    memcpy(&luminances[0], &frame.pixels[0], frame.pixels.size());
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(luminances, frame.width,
+                                                             frame.height, 0, 0,
+                                                             frame.width, frame.height));
+    Ref<Binarizer> binarizer(new HybridBinarizer(source));
+    Ref<BinaryBitmap> bitmap(new BinaryBitmap(binarizer));
+    try {
+      return reader.decode(bitmap, hints)->getText()->getText();
+    } catch (zxing::Exception const&) {
+      return string();
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  int iterations = 50;
+  vector<Frame> frames;
+  frames.push_back(blankFrame());
+  frames.push_back(code39Frame("ZXING-39"));
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      iterations = atoi(argv[++i]);
+      continue;
+    }
+    Frame frame;
+    if (!readPgm(argv[i], frame)) {
+      fprintf(stderr, "%s: not an 8-bit binary PGM\n", argv[i]);
+      return 1;
+    }
+    frames.push_back(frame);
+  }
+
+  MultiFormatReader reader;
+  DecodeHints hints(DecodeHints::DEFAULT_HINT);
+  hints.setTryHarder(false);
+  printf("%-24s %10s %14s  %s\n", "frame", "ms/decode", "throws/decode", "text");
+  for (size_t f = 0; f < frames.size(); f++) {
+    // One untimed decode warms the caches and gives the throw count.
+    long before = throws;
+    string text = decode(frames[f], reader, hints);
+    long frameThrows = throws - before;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      decode(frames[f], reader, hints);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count() / iterations;
+    printf("%-24s %10.3f %14ld  %s\n", frames[f].name.c_str(), ms, frameThrows,
+           text.empty() ? "-" : text.c_str());
+  }
+  return 0;
+}
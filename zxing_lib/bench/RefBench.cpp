@@ -0,0 +1,93 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  RefBench.cpp
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Cost of handing an ArrayRef<char> to a callee, the way the binarizer and
+ * 1D helpers used to take it (by value: a retain and a release per call)
+ * against the ways they take it now (const reference or ArraySpan: no
+ * reference counting), and one moved into a callee and back out. Build with
+ * -DZXING_ATOMIC_REFCOUNT to see the atomic counts.
+ *
+ *   RefBench [calls]
+ */
+
+#include <zxing/common/Array.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+using zxing::ArrayRef;
+using zxing::ArraySpan;
+
+namespace {
+  __attribute__((noinline)) int byValue(ArrayRef<char> array, int i) {
+    return array[i & 63];
+  }
+
+  __attribute__((noinline)) ArrayRef<char> passOn(ArrayRef<char> array, int i, int& value) {
+    value = array[i & 63];
+    return array;
+  }
+
+  __attribute__((noinline)) int byReference(ArrayRef<char> const& array, int i) {
+    return array[i & 63];
+  }
+
+  __attribute__((noinline)) int bySpan(ArraySpan<char> array, int i) {
+    return array[i & 63];
+  }
+
+  template<class Call>
+  void measure(const char* name, int calls, Call call) {
+    ArrayRef<char> array(64);
+    for (int i = 0; i < 64; i++) {
+      array[i] = (char)i;
+    }
+    int sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) {
+      sum += call(array, i);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+      .count() / calls;
+    printf("%-16s %6.2f ns/call  (checksum %d)\n", name, ns, sum);
+  }
+}
+
+int main(int argc, char** argv) {
+  int calls = argc > 1 ? atoi(argv[1]) : 100000000;
+  measure("by value", calls, [](ArrayRef<char>& array, int i) {
+    return byValue(array, i);
+  });
+  measure("moved through", calls, [](ArrayRef<char>& array, int i) {
+    // The reference goes in and comes back out without being counted.
+    int value;
+    array = passOn(std::move(array), i, value);
+    return value;
+  });
+  measure("const reference", calls, [](ArrayRef<char>& array, int i) {
+    return byReference(array, i);
+  });
+  measure("span", calls, [](ArrayRef<char>& array, int i) {
+    return bySpan(array, i);
+  });
+  return 0;
+}
@@ -0,0 +1,222 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  HybridBinarizerTest.cpp
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Checks HybridBinarizer against a plain scalar copy of the Java algorithm:
+ * every block's black point is computed here one pixel at a time and the
+ * image thresholded block by block, and the result must match the library
+ * bit for bit. The Makefile builds this once with the vector block
+ * statistics and once with ZXING_NO_SIMD, so both paths are held to the same
+ * reference grid. Sizes cover the minimum, widths either side of a 16-pixel
+ * vector pair and a 32-bit matrix word, and heights that leave a partial
+ * block row.
+ */
+
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/ThreadPool.h>
+#include <cstdio>
+#include <vector>
+
+using std::vector;
+using zxing::Ref;
+using zxing::ArrayRef;
+using zxing::BitMatrix;
+using zxing::HybridBinarizer;
+using zxing::GreyscaleLuminanceSource;
+using zxing::LuminanceSource;
+using zxing::ThreadPool;
+
+namespace {
+  const int BLOCK_SIZE_POWER = 3;
+  const int BLOCK_SIZE = 1 << BLOCK_SIZE_POWER;
+  const int MIN_DYNAMIC_RANGE = 24;
+
+  // A small LCG, so that a failure can be replayed from its seed.
+  class Random {
+  private:
+    unsigned state_;
+  public:
+    explicit Random(unsigned seed) : state_(seed) {}
+    int next(int bound) {
+      state_ = state_ * 1103515245u + 12345u;
+      return (int)((state_ >> 8) % (unsigned)bound);
+    }
+  };
+
+  int cap(int value, int min, int max) {
+    return value < min ? min : value > max ? max : value;
+  }
+
+  int offset(int block, int size) {
+    int offset = block << BLOCK_SIZE_POWER;
+    return offset > size - BLOCK_SIZE ? size - BLOCK_SIZE : offset;
+  }
+
+  vector<int> referenceBlackPoints(const vector<unsigned char>& pixels,
+                                   int width, int height, int subWidth, int subHeight) {
+    vector<int> blackPoints(subWidth * subHeight);
+    for (int y = 0; y < subHeight; y++) {
+      int yoffset = offset(y, height);
+      for (int x = 0; x < subWidth; x++) {
+        int xoffset = offset(x, width);
+        int sum = 0;
+        int min = 0xFF;
+        int max = 0;
+        for (int yy = 0; yy < BLOCK_SIZE; yy++) {
+          for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+            int pixel = pixels[(yoffset + yy) * width + xoffset + xx];
+            sum += pixel;
+            min = pixel < min ? pixel : min;
+            max = pixel > max ? pixel : max;
+          }
+        }
+        int average = sum >> (BLOCK_SIZE_POWER * 2);
+        if (max - min <= MIN_DYNAMIC_RANGE) {
+          average = min >> 1;
+          if (y > 0 && x > 0) {
+            int bp = (blackPoints[(y - 1) * subWidth + x] +
+                      2 * blackPoints[y * subWidth + x - 1] +
+                      blackPoints[(y - 1) * subWidth + x - 1]) >> 2;
+            if (min < bp) {
+              average = bp;
+            }
+          }
+        }
+        blackPoints[y * subWidth + x] = average;
+      }
+    }
+    return blackPoints;
+  }
+
+  vector<bool> referenceMatrix(const vector<unsigned char>& pixels, int width, int height) {
+    int subWidth = (width + BLOCK_SIZE - 1) >> BLOCK_SIZE_POWER;
+    int subHeight = (height + BLOCK_SIZE - 1) >> BLOCK_SIZE_POWER;
+    vector<int> blackPoints = referenceBlackPoints(pixels, width, height, subWidth, subHeight);
+    vector<bool> black(width * height);
+    for (int y = 0; y < subHeight; y++) {
+      int yoffset = offset(y, height);
+      int top = cap(y, 2, subHeight - 3);
+      for (int x = 0; x < subWidth; x++) {
+        int xoffset = offset(x, width);
+        int left = cap(x, 2, subWidth - 3);
+        int sum = 0;
+        for (int z = -2; z <= 2; z++) {
+          for (int w = -2; w <= 2; w++) {
+            sum += blackPoints[(top + z) * subWidth + left + w];
+          }
+        }
+        int threshold = sum / 25;
+        for (int yy = 0; yy < BLOCK_SIZE; yy++) {
+          for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+            int i = (yoffset + yy) * width + xoffset + xx;
+            if (pixels[i] <= threshold) {
+              black[i] = true;
+            }
+          }
+        }
+      }
+    }
+    return black;
+  }
+
+  /*
+   * Noise whose 8x8 patches are either full range or confined to a narrow
+   * band, so that both the local average and the neighbour fallback for
+   * flat blocks are exercised, including at the overlapping edge blocks.
+   */
+  vector<unsigned char> makeImage(int width, int height, unsigned seed) {
+    Random random(seed);
+    int patchesWide = (width + 7) / 8;
+    int patchesHigh = (height + 7) / 8;
+    vector<int> base(patchesWide * patchesHigh);
+    vector<int> spread(patchesWide * patchesHigh);
+    for (size_t i = 0; i < base.size(); i++) {
+      base[i] = random.next(256);
+      spread[i] = random.next(3) == 0 ? 256 : 1 + random.next(MIN_DYNAMIC_RANGE + 2);
+    }
+    vector<unsigned char> pixels(width * height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        int patch = (y / 8) * patchesWide + x / 8;
+        int value = spread[patch] == 256 ? random.next(256)
+          : base[patch] + random.next(spread[patch]);
+        pixels[y * width + x] = (unsigned char)(value > 255 ? 255 : value);
+      }
+    }
+    return pixels;
+  }
+
+  bool check(int width, int height, unsigned seed, Ref<ThreadPool> pool) {
+    vector<unsigned char> pixels = makeImage(width, height, seed);
+    ArrayRef<char> data(width * height);
+    for (int i = 0; i < width * height; i++) {
+      data[i] = (char)pixels[i];
+    }
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(data, width, height, 0, 0,
+                                                             width, height));
+    Ref<HybridBinarizer> binarizer(pool ? new HybridBinarizer(source, pool)
+                                   : new HybridBinarizer(source));
+    Ref<BitMatrix> matrix = binarizer->getBlackMatrix();
+    vector<bool> expected = referenceMatrix(pixels, width, height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        if (matrix->get(x, y) != expected[y * width + x]) {
+          printf("FAIL %dx%d seed %u threads %d: pixel (%d,%d) is %s, expected %s\n",
+                 width, height, seed, pool ? pool->getThreadCount() : 1, x, y,
+                 matrix->get(x, y) ? "black" : "white",
+                 expected[y * width + x] ? "black" : "white");
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+int main() {
+  static const int SIZES[] = {
+    40, 41, 47, 48, 55, 63, 64, 65, 71, 95, 96, 97, 127, 128, 129, 200, 321
+  };
+  const int sizeCount = (int)(sizeof(SIZES) / sizeof(SIZES[0]));
+  Ref<ThreadPool> pools[] = { Ref<ThreadPool>(), Ref<ThreadPool>(new ThreadPool(3)) };
+  int runs = 0;
+  int failures = 0;
+  for (int p = 0; p < 2; p++) {
+    for (int w = 0; w < sizeCount; w++) {
+      for (int h = 0; h < sizeCount; h += 3) {
+        for (unsigned seed = 1; seed <= 4; seed++) {
+          runs++;
+          if (!check(SIZES[w], SIZES[h], seed * 7919u + SIZES[w] * 131u + SIZES[h], pools[p])) {
+            failures++;
+          }
+        }
+      }
+    }
+  }
+#if defined(ZXING_NO_SIMD)
+  const char* path = "scalar";
+#else
+  const char* path = "vector";
+#endif
+  printf("HybridBinarizer (%s): %d of %d images match the reference\n",
+         path, runs - failures, runs);
+  return failures == 0 ? 0 : 1;
+}
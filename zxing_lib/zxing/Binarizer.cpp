@@ -30,6 +30,17 @@ namespace zxing {
 	Binarizer::~Binarizer() {
 	}
 	
+	void Binarizer::reset() {
+	}
+
+  ArrayRef<int> Binarizer::getBandContrast() {
+    return ArrayRef<int>();
+  }
+
+  int Binarizer::getContrastBandHeight() const {
+    return 0;
+  }
+	
 	Ref<LuminanceSource> Binarizer::getLuminanceSource() const {
 		return source_;
 	}
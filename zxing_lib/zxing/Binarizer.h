@@ -38,6 +38,17 @@ class Binarizer : public Counted {
   virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row) = 0;
   virtual Ref<BitMatrix> getBlackMatrix() = 0;
 
+  // Forgets anything computed from the luminance source, for callers that
+  // refill the source's pixels in place between frames. Buffers are kept
+  // and reused, so results from before the reset must no longer be used.
+  virtual void reset();
+
+  // How much local contrast each band of getContrastBandHeight() rows
+  // holds, top to bottom, for callers that want to look at the busy parts
+  // of the image first. Empty when the binarizer keeps no such statistics.
+  virtual ArrayRef<int> getBandContrast();
+  virtual int getContrastBandHeight() const;
+
   Ref<LuminanceSource> getLuminanceSource() const ;
   virtual Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source) = 0;
 
@@ -16,55 +16,119 @@
  */
 
 #include <zxing/BinaryBitmap.h>
+#include <zxing/common/IllegalArgumentException.h>
 
 using zxing::Ref;
 using zxing::BitArray;
 using zxing::BitMatrix;
 using zxing::LuminanceSource;
 using zxing::BinaryBitmap;
+using zxing::ArrayRef;
+using zxing::IllegalArgumentException;
 	
 // VC++
 using zxing::Binarizer;
 
 BinaryBitmap::BinaryBitmap(Ref<Binarizer> binarizer) : binarizer_(binarizer) {
 }
+
+BinaryBitmap::BinaryBitmap() : binarizer_(), matrix_() {
+}
+
+Ref<BinaryBitmap> BinaryBitmap::wrap(Ref<BitMatrix> matrix) {
+  Ref<BinaryBitmap> bitmap(new BinaryBitmap());
+  bitmap->matrix_ = matrix;
+  return bitmap;
+}
 	
 BinaryBitmap::~BinaryBitmap() {
 }
 	
 Ref<BitArray> BinaryBitmap::getBlackRow(int y, Ref<BitArray> row) {
+  if (!binarizer_) {
+    return matrix_->getRow(y, row);
+  }
   return binarizer_->getBlackRow(y, row);
 }
 	
+/**
+ * Every 2D reader asks for the matrix, so it is binarized once and shared
+ * by all of them until reset().
+ */
 Ref<BitMatrix> BinaryBitmap::getBlackMatrix() {
-  return binarizer_->getBlackMatrix();
+  if (!matrix_) {
+    matrix_ = binarizer_->getBlackMatrix();
+  }
+  return matrix_;
+}
+
+void BinaryBitmap::reset() {
+  if (!binarizer_) {
+    return; // Nothing to recompute the matrix from
+  }
+  matrix_.reset(0);
+  binarizer_->reset();
+}
+
+ArrayRef<int> BinaryBitmap::getBandContrast() {
+  if (!binarizer_) {
+    return ArrayRef<int>();
+  }
+  return binarizer_->getBandContrast();
+}
+
+int BinaryBitmap::getContrastBandHeight() const {
+  if (!binarizer_) {
+    return 0;
+  }
+  return binarizer_->getContrastBandHeight();
 }
 	
 int BinaryBitmap::getWidth() const {
+  if (!binarizer_) {
+    return matrix_->getWidth();
+  }
   return getLuminanceSource()->getWidth();
 }
 	
 int BinaryBitmap::getHeight() const {
+  if (!binarizer_) {
+    return matrix_->getHeight();
+  }
   return getLuminanceSource()->getHeight();
 }
 	
 Ref<LuminanceSource> BinaryBitmap::getLuminanceSource() const {
+  if (!binarizer_) {
+    return Ref<LuminanceSource>();
+  }
   return binarizer_->getLuminanceSource();
 }
 	
 
 bool BinaryBitmap::isCropSupported() const {
-  return getLuminanceSource()->isCropSupported();
+  return binarizer_ && getLuminanceSource()->isCropSupported();
 }
 
 Ref<BinaryBitmap> BinaryBitmap::crop(int left, int top, int width, int height) {
+  if (!binarizer_) {
+    throw IllegalArgumentException("This bitmap does not support cropping.");
+  }
   return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->crop(left, top, width, height))));
 }
 
 bool BinaryBitmap::isRotateSupported() const {
-  return getLuminanceSource()->isRotateSupported();
+  return true;
 }
 
 Ref<BinaryBitmap> BinaryBitmap::rotateCounterClockwise() {
-  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->rotateCounterClockwise())));
+  return wrap(getBlackMatrix()->rotateCounterClockwise());
+}
+
+Ref<BinaryBitmap> BinaryBitmap::rotate180() {
+  return wrap(getBlackMatrix()->rotate180());
+}
+
+Ref<BinaryBitmap> BinaryBitmap::rotateClockwise() {
+  return wrap(getBlackMatrix()->rotateClockwise());
 }
@@ -30,6 +30,12 @@ namespace zxing {
 	class BinaryBitmap : public Counted {
 	private:
 		Ref<Binarizer> binarizer_;
+		Ref<BitMatrix> matrix_;
+
+		// A bitmap over a matrix that is already binarized, with no binarizer
+		// or luminance source behind it. Rows are read straight from matrix.
+		BinaryBitmap();
+		static Ref<BinaryBitmap> wrap(Ref<BitMatrix> matrix);
 		
 	public:
 		BinaryBitmap(Ref<Binarizer> binarizer);
@@ -37,14 +43,22 @@ namespace zxing {
 		
 		Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
 		Ref<BitMatrix> getBlackMatrix();
+		void reset();
+
+		ArrayRef<int> getBandContrast();
+		int getContrastBandHeight() const;
 		
 		Ref<LuminanceSource> getLuminanceSource() const;
 
 		int getWidth() const;
 		int getHeight() const;
 
+		// Rotations turn the black matrix rather than the luminance source,
+		// so they are always supported and binarize nothing again.
 		bool isRotateSupported() const;
 		Ref<BinaryBitmap> rotateCounterClockwise();
+		Ref<BinaryBitmap> rotate180();
+		Ref<BinaryBitmap> rotateClockwise();
 
 		bool isCropSupported() const;
 		Ref<BinaryBitmap> crop(int left, int top, int width, int height);
@@ -19,12 +19,14 @@
  */
 
 #include <zxing/DecodeHints.h>
+#include <zxing/oned/ScanlineScheduler.h>
 #include <zxing/common/IllegalArgumentException.h>
 
 using zxing::Ref;
 using zxing::ResultPointCallback;
 using zxing::DecodeHintType;
 using zxing::DecodeHints;
+using zxing::oned::ScanlineScheduler;
 
 // VC++
 using zxing::BarcodeFormat;
@@ -58,10 +60,28 @@ const DecodeHints DecodeHints::DEFAULT_HINT(
 
 DecodeHints::DecodeHints() {
   hints = 0;
+  binarizerWindowSize = 0;
 }
 
 DecodeHints::DecodeHints(DecodeHintType init) {
   hints = init;
+  binarizerWindowSize = 0;
+}
+
+DecodeHints::DecodeHints(DecodeHints const& other) :
+  hints(other.hints), callback(other.callback), binarizerWindowSize(other.binarizerWindowSize),
+  scanlineScheduler(other.scanlineScheduler) {
+}
+
+DecodeHints::~DecodeHints() {
+}
+
+DecodeHints& DecodeHints::operator =(DecodeHints const& other) {
+  hints = other.hints;
+  callback = other.callback;
+  binarizerWindowSize = other.binarizerWindowSize;
+  scanlineScheduler = other.scanlineScheduler;
+  return *this;
 }
 
 void DecodeHints::addFormat(BarcodeFormat toadd) {
@@ -132,11 +152,33 @@ Ref<ResultPointCallback> DecodeHints::getResultPointCallback() const {
   return callback;
 }
 
+void DecodeHints::setBinarizerWindowSize(int size) {
+  binarizerWindowSize = size;
+}
+
+int DecodeHints::getBinarizerWindowSize() const {
+  return binarizerWindowSize;
+}
+
+void DecodeHints::setScanlineScheduler(Ref<ScanlineScheduler> const& scheduler) {
+  scanlineScheduler = scheduler;
+}
+
+Ref<ScanlineScheduler> DecodeHints::getScanlineScheduler() const {
+  return scanlineScheduler;
+}
+
 DecodeHints zxing::operator | (DecodeHints const& l, DecodeHints const& r) {
   DecodeHints result (l);
   result.hints |= r.hints;
   if (!result.callback) {
     result.callback = r.callback;
   }
+  if (!result.binarizerWindowSize) {
+    result.binarizerWindowSize = r.binarizerWindowSize;
+  }
+  if (!result.scanlineScheduler) {
+    result.scanlineScheduler = r.scanlineScheduler;
+  }
   return result;
 }
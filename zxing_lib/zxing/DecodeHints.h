@@ -25,6 +25,10 @@
 
 namespace zxing {
 
+namespace oned {
+class ScanlineScheduler;
+}
+
 typedef unsigned int DecodeHintType;
 class DecodeHints;
 DecodeHints operator | (DecodeHints const&, DecodeHints const&);
@@ -33,6 +37,8 @@ class DecodeHints {
  private:
   DecodeHintType hints;
   Ref<ResultPointCallback> callback;
+  int binarizerWindowSize;
+  Ref<oned::ScanlineScheduler> scanlineScheduler;
 
  public:
   static const DecodeHintType AZTEC_HINT = 1 << BarcodeFormat::AZTEC;
@@ -70,6 +76,11 @@ class DecodeHints {
 
   DecodeHints();
   DecodeHints(DecodeHintType init);
+  // Out of line, so that only the 1D readers need the full
+  // oned::ScanlineScheduler.
+  DecodeHints(DecodeHints const& other);
+  ~DecodeHints();
+  DecodeHints& operator =(DecodeHints const& other);
 
   void addFormat(BarcodeFormat toadd);
   bool containsFormat(BarcodeFormat tocheck) const;
@@ -81,6 +92,16 @@ class DecodeHints {
   void setResultPointCallback(Ref<ResultPointCallback> const&);
   Ref<ResultPointCallback> getResultPointCallback() const;
 
+  // Side of the square window used by IntegralImageBinarizer, in pixels;
+  // 0 leaves the binarizer's default.
+  void setBinarizerWindowSize(int size);
+  int getBinarizerWindowSize() const;
+
+  // Picks the rows the 1D readers look at; none keeps their usual
+  // middle-out order.
+  void setScanlineScheduler(Ref<oned::ScanlineScheduler> const& scheduler);
+  Ref<oned::ScanlineScheduler> getScanlineScheduler() const;
+
   friend DecodeHints operator | (DecodeHints const&, DecodeHints const&);
 };
 
@@ -111,11 +111,9 @@ void MultiFormatReader::setHints(DecodeHints hints) {
 
 Ref<Result> MultiFormatReader::decodeInternal(Ref<BinaryBitmap> image) {
   for (unsigned int i = 0; i < readers_.size(); i++) {
-    try {
-      return readers_[i]->decode(image, hints_);
-    } catch (ReaderException const& re) {
-      (void)re;
-      // continue
+    Ref<Result> result = readers_[i]->tryDecode(image, hints_);
+    if (!result.empty()) {
+      return result;
     }
   }
   throw ReaderException("No code detected");
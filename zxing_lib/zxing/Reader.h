@@ -32,6 +32,14 @@ namespace zxing {
   public:
    virtual Ref<Result> decode(Ref<BinaryBitmap> image);
    virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints) = 0;
+
+   /*
+    * Like decode(), but returns an empty Ref where decode() would throw a
+    * ReaderException. Readers whose search misses often, such as the row
+    * scanning 1D readers, override it so that a frame without a barcode
+    * does not cost an exception per attempt.
+    */
+   virtual Ref<Result> tryDecode(Ref<BinaryBitmap> image, DecodeHints hints);
    virtual ~Reader();
 };
 
@@ -22,11 +22,12 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <vector>
 
 namespace zxing {
 
-class ResultPoint : public Counted {
+class ResultPoint : public Counted, public ArenaAllocated {
 protected:
   const float posX_;
   const float posY_;
@@ -0,0 +1,211 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Arena.cpp
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Arena.h>
+#include <zxing/common/Counted.h>
+#include <new>
+
+// The current arena is per thread where the toolchain provides thread-local
+// storage. mbed OS builds have none, though the RTOS may run the decode
+// alongside other threads, ThreadPool workers among them. There the current
+// arena is global and owned by one thread at a time: the first to open a
+// scope keeps it until its outermost scope closes. Scopes opened meanwhile
+// on any other thread do nothing, and that thread's objects come from the
+// heap.
+#if defined(__MBED__)
+#define ZXING_ARENA_THREAD_LOCAL
+#define ZXING_ARENA_OWNED 1
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include "rtos.h"
+#endif
+#elif __cplusplus >= 201103L
+#define ZXING_ARENA_THREAD_LOCAL thread_local
+#elif defined(__GNUC__)
+#define ZXING_ARENA_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define ZXING_ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define ZXING_ARENA_THREAD_LOCAL
+#endif
+
+using zxing::Arena;
+using zxing::ArenaAllocated;
+
+namespace {
+  // Keeps every allocation, and so every object, 8-byte aligned.
+  const size_t ALIGNMENT = 8;
+
+  inline size_t align(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  ZXING_ARENA_THREAD_LOCAL Arena* currentArena = 0;
+
+#if defined(ZXING_ARENA_OWNED)
+  // The thread whose scopes are open, or null.
+  void* arenaOwner = 0;
+
+  inline void* thisThread() {
+#if defined(MBED_CONF_RTOS_PRESENT)
+    return (void*)osThreadGetId();
+#else
+    return (void*)&arenaOwner; // Without the RTOS there is only one thread
+#endif
+  }
+
+  // Makes this thread the owner unless another one already is.
+  inline bool claimArena() {
+    void* self = thisThread();
+    return zxing::detail::publishShared(&arenaOwner, self) == self;
+  }
+
+  inline void releaseArena() {
+#if defined(__GNUC__)
+    __atomic_store_n(&arenaOwner, (void*)0, __ATOMIC_RELEASE);
+#else
+    arenaOwner = 0;
+#endif
+  }
+
+  inline Arena* ownArena() {
+    return zxing::detail::loadShared(&arenaOwner) == thisThread() ? currentArena : 0;
+  }
+#else
+  inline bool claimArena() {
+    return true;
+  }
+
+  inline void releaseArena() {
+  }
+
+  inline Arena* ownArena() {
+    return currentArena;
+  }
+#endif
+
+  /*
+   * Precedes every ArenaAllocated object so delete can tell arena memory,
+   * which is reclaimed by Arena::reset(), from heap memory.
+   */
+  union Header {
+    bool inArena;
+    double alignment;
+  };
+}
+
+struct Arena::Chunk {
+  Chunk* next;
+  size_t size;
+
+  char* data() {
+    return reinterpret_cast<char*>(this) + align(sizeof(Chunk));
+  }
+};
+
+Arena::Arena(size_t chunkSize)
+  : chunkSize_(chunkSize), first_(0), chunk_(0), used_(0), bytesUsed_(0) {
+}
+
+Arena::~Arena() {
+  while (first_) {
+    Chunk* next = first_->next;
+    ::operator delete(first_);
+    first_ = next;
+  }
+}
+
+void* Arena::allocate(size_t size) {
+  size = align(size);
+  if (!chunk_ || used_ + size > chunk_->size) {
+    // Move on to the next chunk kept from an earlier decode if it is big
+    // enough, otherwise splice a new one in after the current chunk.
+    Chunk* next = chunk_ ? chunk_->next : first_;
+    if (!next || next->size < size) {
+      size_t chunkSize = size > chunkSize_ ? size : chunkSize_;
+      Chunk* fresh = static_cast<Chunk*>(::operator new(align(sizeof(Chunk)) + chunkSize));
+      fresh->size = chunkSize;
+      fresh->next = next;
+      if (chunk_) {
+        chunk_->next = fresh;
+      } else {
+        first_ = fresh;
+      }
+      next = fresh;
+    }
+    chunk_ = next;
+    used_ = 0;
+  }
+  void* p = chunk_->data() + used_;
+  used_ += size;
+  bytesUsed_ += size;
+  return p;
+}
+
+void Arena::reset() {
+  chunk_ = 0;
+  used_ = 0;
+  bytesUsed_ = 0;
+}
+
+size_t Arena::getBytesUsed() const {
+  return bytesUsed_;
+}
+
+Arena::Scope::Scope(Arena& arena) : previous_(0), active_(claimArena()) {
+  if (active_) {
+    previous_ = currentArena;
+    currentArena = &arena;
+  }
+}
+
+Arena::Scope::~Scope() {
+  if (active_) {
+    currentArena = previous_;
+    if (!previous_) {
+      releaseArena();
+    }
+  }
+}
+
+Arena* Arena::current() {
+  return ownArena();
+}
+
+void* ArenaAllocated::operator new(size_t size) {
+  Arena* arena = ownArena();
+  Header* header;
+  if (arena) {
+    header = static_cast<Header*>(arena->allocate(sizeof(Header) + size));
+  } else {
+    header = static_cast<Header*>(::operator new(sizeof(Header) + size));
+  }
+  header->inArena = arena != 0;
+  return header + 1;
+}
+
+void ArenaAllocated::operator delete(void* p) {
+  if (!p) {
+    return;
+  }
+  Header* header = static_cast<Header*>(p) - 1;
+  if (!header->inArena) {
+    ::operator delete(header);
+  }
+}
@@ -0,0 +1,103 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+/*
+ *  Arena.h
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+
+namespace zxing {
+
+/**
+ * A monotonic buffer for the short-lived objects of one decode.
+ *
+ * Allocation bumps a pointer through a list of chunks; freeing is a no-op.
+ * reset() rewinds to the first chunk in constant time and keeps every chunk
+ * for the next decode, so a steady stream of frames stops touching the heap
+ * once the arena has grown to the largest decode.
+ *
+ * Only types deriving from ArenaAllocated are placed in the arena, and only
+ * while an Arena::Scope for it is open on the allocating thread. All of them
+ * must be destroyed before reset(); results that outlive the decode must be
+ * copied out first.
+ */
+class Arena {
+public:
+  explicit Arena(size_t chunkSize = 16 * 1024);
+  ~Arena();
+
+  void* allocate(size_t size);
+  void reset();
+
+  // Bytes handed out since the last reset().
+  size_t getBytesUsed() const;
+
+  /**
+   * Routes ArenaAllocated types created on this thread into the arena
+   * until the scope closes. Scopes nest.
+   *
+   * Where there is no thread-local storage (mbed OS), only one thread at a
+   * time has its scopes take effect: the first to open one, until its
+   * outermost scope closes. Scopes opened on other threads meanwhile do
+   * nothing, so ThreadPool jobs and concurrent decodes allocate from the
+   * heap rather than from an arena another thread is using.
+   */
+  class Scope {
+  private:
+    Arena* previous_;
+    bool active_;
+
+    Scope(const Scope&);
+    Scope& operator =(const Scope&);
+  public:
+    explicit Scope(Arena& arena);
+    ~Scope();
+  };
+
+  // The arena of the innermost open scope on this thread, or null.
+  static Arena* current();
+
+private:
+  struct Chunk;
+
+  size_t chunkSize_;
+  Chunk* first_;
+  Chunk* chunk_;
+  size_t used_;
+  size_t bytesUsed_;
+
+  Arena(const Arena&);
+  Arena& operator =(const Arena&);
+};
+
+/**
+ * Base for transient types that may live in an Arena. Objects created
+ * outside an Arena::Scope come from the heap as usual; either kind is
+ * released through delete.
+ */
+class ArenaAllocated {
+public:
+  static void* operator new(size_t size);
+  static void operator delete(void* p);
+};
+
+}
+
+#endif // __ARENA_H__
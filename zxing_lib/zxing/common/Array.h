@@ -107,6 +107,13 @@ public:
     reset(other.array_);
   }
 
+#if __cplusplus >= 201103L
+  ArrayRef(ArrayRef &&other) :
+      Counted(), array_(other.array_) {
+    other.array_ = 0;
+  }
+#endif
+
   template<class Y>
   ArrayRef(const ArrayRef<Y> &other) :
       array_(0) {
@@ -144,6 +151,19 @@ public:
     reset(other);
     return *this;
   }
+#if __cplusplus >= 201103L
+  ArrayRef<T>& operator=(ArrayRef<T> &&other) {
+    if (this != &other) {
+      Array<T> *old = array_;
+      array_ = other.array_;
+      other.array_ = 0;
+      if (old) {
+        old->release();
+      }
+    }
+    return *this;
+  }
+#endif
   ArrayRef<T>& operator=(Array<T> *a) {
     reset(a);
     return *this;
@@ -165,6 +185,44 @@ public:
   }
 };
 
+/*
+ * A borrowed view of an array's elements: a pointer and a length, with no
+ * reference counting. For inner loops and helpers that only read or write
+ * the elements; it must not outlive the ArrayRef it was taken from.
+ */
+template<typename T> class ArraySpan {
+private:
+  T *data_;
+  int size_;
+public:
+  ArraySpan() :
+      data_(0), size_(0) {
+  }
+  ArraySpan(T *data, int size) :
+      data_(data), size_(size) {
+  }
+  ArraySpan(const ArrayRef<T> &array) :
+      data_(0), size_(0) {
+    if (array && !array->empty()) {
+      data_ = &array->values_[0];
+      size_ = array->size();
+    }
+  }
+
+  T& operator[](int i) const {
+    return data_[i];
+  }
+  T* data() const {
+    return data_;
+  }
+  int size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+};
+
 } // namespace zxing
 
 #endif // __ARRAY_H__
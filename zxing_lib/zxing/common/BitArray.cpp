@@ -16,9 +16,11 @@
  */
 
 #include <zxing/common/BitArray.h>
+#include <zxing/common/BitUtils.h>
 
 using std::vector;
 using zxing::BitArray;
+using zxing::BitUtils;
 
 // VC++
 using zxing::Ref;
@@ -61,15 +63,7 @@ bool BitArray::isRange(int start, int end, bool value) {
   for (int i = firstInt; i <= lastInt; i++) {
     int firstBit = i > firstInt ? 0 : start & bitsMask;
     int lastBit = i < lastInt ? (bitsPerWord-1) : end & bitsMask;
-    int mask;
-    if (firstBit == 0 && lastBit == (bitsPerWord-1)) {
-      mask = -1;
-    } else {
-      mask = 0;
-      for (int j = firstBit; j <= lastBit; j++) {
-        mask |= 1 << j;
-      }
-    }
+    int mask = BitUtils::rangeMask(firstBit, lastBit);
     
     // Return false if we're looking for 1s and the masked bits[i] isn't all 1s (that is,
     // equals the mask, or we're looking for 0s and the masked portion is not all 0s
@@ -103,36 +97,25 @@ BitArray::Reverse::~Reverse() {
   array->reverse();
 }
 
-namespace {
-  // N.B.: This only works for 32 bit ints ...
-  int numberOfTrailingZeros(int i) {
-    // HD, Figure 5-14
-    int y;
-    if (i == 0) return 32;
-    int n = 31;
-    y = i <<16; if (y != 0) { n = n -16; i = y; }
-    y = i << 8; if (y != 0) { n = n - 8; i = y; }
-    y = i << 4; if (y != 0) { n = n - 4; i = y; }
-    y = i << 2; if (y != 0) { n = n - 2; i = y; }
-    return n - (((unsigned int)(i << 1)) >> 31);
-  }
-}
+// getNextSet() and getNextUnset() skip whole words that hold no candidate
+// bit and then take the lowest one with a single count-trailing-zeros.
 
 int BitArray::getNextSet(int from) {
   if (from >= size) {
     return size;
   }
+  int const* words = &bits[0];
+  int numWords = bits->size();
   int bitsOffset = from >> logBits;
-  int currentBits = bits[bitsOffset];
   // mask off lesser bits first
-  currentBits &= ~((1 << (from & bitsMask)) - 1);
+  unsigned int currentBits = words[bitsOffset] & (~0u << (from & bitsMask));
   while (currentBits == 0) {
-    if (++bitsOffset == (int)bits->size()) {
+    if (++bitsOffset == numWords) {
       return size;
     }
-    currentBits = bits[bitsOffset];
+    currentBits = words[bitsOffset];
   }
-  int result = (bitsOffset << logBits) + numberOfTrailingZeros(currentBits);
+  int result = (bitsOffset << logBits) + BitUtils::numberOfTrailingZeros(currentBits);
   return result > size ? size : result;
 }
 
@@ -140,16 +123,17 @@ int BitArray::getNextUnset(int from) {
   if (from >= size) {
     return size;
   }
+  int const* words = &bits[0];
+  int numWords = bits->size();
   int bitsOffset = from >> logBits;
-  int currentBits = ~bits[bitsOffset];
   // mask off lesser bits first
-  currentBits &= ~((1 << (from & bitsMask)) - 1);
+  unsigned int currentBits = ~words[bitsOffset] & (~0u << (from & bitsMask));
   while (currentBits == 0) {
-    if (++bitsOffset == (int)bits->size()) {
+    if (++bitsOffset == numWords) {
       return size;
     }
-    currentBits = ~bits[bitsOffset];
+    currentBits = ~words[bitsOffset];
   }
-  int result = (bitsOffset << logBits) + numberOfTrailingZeros(currentBits);
+  int result = (bitsOffset << logBits) + BitUtils::numberOfTrailingZeros(currentBits);
   return result > size ? size : result;
 }
@@ -16,17 +16,20 @@
  */
 
 #include <zxing/common/BitMatrix.h>
+#include <zxing/common/BitUtils.h>
 #include <zxing/common/IllegalArgumentException.h>
 
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cstring>
 
 using std::ostream;
 using std::ostringstream;
 
 using zxing::BitMatrix;
 using zxing::BitArray;
+using zxing::BitUtils;
 using zxing::ArrayRef;
 using zxing::Ref;
 
@@ -50,42 +53,208 @@ BitMatrix::BitMatrix(int width, int height) {
 
 BitMatrix::~BitMatrix() {}
 
+void BitMatrix::clear() {
+  int max = bits->size();
+  for (int i = 0; i < max; i++) {
+    bits[i] = 0;
+  }
+}
+
 void BitMatrix::flip(int x, int y) {
   int offset = y * rowSize + (x >> logBits);
   bits[offset] ^= 1 << (x & bitsMask);
 }
 
-void BitMatrix::setRegion(int left, int top, int width, int height) {
+void BitMatrix::checkRegion(int left, int top, int width, int height) const {
   if (top < 0 || left < 0) {
     throw IllegalArgumentException("Left and top must be nonnegative");
   }
   if (height < 1 || width < 1) {
     throw IllegalArgumentException("Height and width must be at least 1");
   }
+  if (top + height > this->height || left + width > this->width) {
+    throw IllegalArgumentException("The region must fit inside the matrix");
+  }
+}
+
+// The region operations below work a word at a time: the columns
+// [left, right) of a row span the words firstWord..lastWord, of which only
+// the two ends are partially covered and need masking.
+
+void BitMatrix::setRegion(int left, int top, int width, int height) {
+  checkRegion(left, top, width, height);
   int right = left + width;
   int bottom = top + height;
-  if (bottom > this->height || right > this->width) {
-    throw IllegalArgumentException("The region must fit inside the matrix");
+  int firstWord = left >> logBits;
+  int lastWord = (right - 1) >> logBits;
+  int firstMask = BitUtils::rangeMask(left & bitsMask, bitsPerWord - 1);
+  int lastMask = BitUtils::rangeMask(0, (right - 1) & bitsMask);
+  if (firstWord == lastWord) {
+    firstMask &= lastMask;
+  }
+  for (int y = top; y < bottom; y++) {
+    int* row = getRowBits(y);
+    row[firstWord] |= firstMask;
+    if (firstWord != lastWord) {
+      for (int i = firstWord + 1; i < lastWord; i++) {
+        row[i] = -1;
+      }
+      row[lastWord] |= lastMask;
+    }
+  }
+}
+
+void BitMatrix::xorRegion(int left, int top, int width, int height, BitMatrix const& mask) {
+  checkRegion(left, top, width, height);
+  int right = left + width;
+  int bottom = top + height;
+  if (bottom > mask.height || right > mask.width) {
+    throw IllegalArgumentException("The mask must cover the region");
+  }
+  int firstWord = left >> logBits;
+  int lastWord = (right - 1) >> logBits;
+  int firstMask = BitUtils::rangeMask(left & bitsMask, bitsPerWord - 1);
+  int lastMask = BitUtils::rangeMask(0, (right - 1) & bitsMask);
+  if (firstWord == lastWord) {
+    firstMask &= lastMask;
+  }
+  for (int y = top; y < bottom; y++) {
+    int* row = getRowBits(y);
+    int const* maskRow = &mask.bits[y * mask.rowSize];
+    row[firstWord] ^= maskRow[firstWord] & firstMask;
+    if (firstWord != lastWord) {
+      for (int i = firstWord + 1; i < lastWord; i++) {
+        row[i] ^= maskRow[i];
+      }
+      row[lastWord] ^= maskRow[lastWord] & lastMask;
+    }
+  }
+}
+
+int BitMatrix::countSetBits(int left, int top, int width, int height) const {
+  checkRegion(left, top, width, height);
+  int right = left + width;
+  int bottom = top + height;
+  int firstWord = left >> logBits;
+  int lastWord = (right - 1) >> logBits;
+  unsigned int firstMask = BitUtils::rangeMask(left & bitsMask, bitsPerWord - 1);
+  unsigned int lastMask = BitUtils::rangeMask(0, (right - 1) & bitsMask);
+  if (firstWord == lastWord) {
+    firstMask &= lastMask;
   }
+  int count = 0;
   for (int y = top; y < bottom; y++) {
-    int offset = y * rowSize;
-    for (int x = left; x < right; x++) {
-      bits[offset + (x >> logBits)] |= 1 << (x & bitsMask);
+    int const* row = &bits[y * rowSize];
+    count += BitUtils::bitCount(row[firstWord] & firstMask);
+    if (firstWord != lastWord) {
+      for (int i = firstWord + 1; i < lastWord; i++) {
+        count += BitUtils::bitCount(row[i]);
+      }
+      count += BitUtils::bitCount(row[lastWord] & lastMask);
     }
   }
+  return count;
 }
 
 Ref<BitArray> BitMatrix::getRow(int y, Ref<BitArray> row) {
   if (row.empty() || row->getSize() < width) {
     row = new BitArray(width);
   }
-  int offset = y * rowSize;
-  for (int x = 0; x < rowSize; x++) {
-    row->setBulk(x << logBits, bits[offset + x]);
-  }
+  // A row of this matrix and a BitArray of at least its width share a layout.
+  memcpy(&row->getBitArray()[0], &bits[y * rowSize], rowSize * sizeof(int));
   return row;
 }
 
+namespace {
+
+// Swaps bits j..2j-1 of each row k with bits 0..j-1 of row k + j, for
+// every k whose bit j is clear; mask selects bits 0..j-1 of each 2j.
+inline void swapBlocks(unsigned int* block, int j, unsigned int mask) {
+  for (int k = 0; k < 32; k = (k + j + 1) & ~j) {
+    unsigned int t = ((block[k] >> j) ^ block[k + j]) & mask;
+    block[k + j] ^= t;
+    block[k] ^= t << j;
+  }
+}
+
+// Transposes the 32x32 bits of block in place, column x of row y being bit
+// x of block[y]: swaps the off-diagonal halves, then the off-diagonal
+// quarters of each half, and so on down to single bits. The steps are
+// spelled out so that each loop can be unrolled.
+void transposeBlock(unsigned int* block) {
+  swapBlocks(block, 16, 0x0000FFFF);
+  swapBlocks(block, 8, 0x00FF00FF);
+  swapBlocks(block, 4, 0x0F0F0F0F);
+  swapBlocks(block, 2, 0x33333333);
+  swapBlocks(block, 1, 0x55555555);
+}
+
+}
+
+Ref<BitMatrix> BitMatrix::transpose() const {
+  return transpose(false, false);
+}
+
+Ref<BitMatrix> BitMatrix::rotateCounterClockwise() const {
+  // Column x becomes row width - 1 - x
+  return transpose(false, true);
+}
+
+Ref<BitMatrix> BitMatrix::rotateClockwise() const {
+  // Column x becomes row x, read bottom up
+  return transpose(true, false);
+}
+
+// Transposes this matrix, mirrored top to bottom first if flipBefore, and
+// mirrors the result top to bottom if flipAfter.
+Ref<BitMatrix> BitMatrix::transpose(bool flipBefore, bool flipAfter) const {
+  Ref<BitMatrix> result(new BitMatrix(height, width));
+  int const* from = &bits[0];
+  int* to = &result->bits[0];
+  int toRowSize = result->rowSize;
+  unsigned int block[32];
+  for (int top = 0; top < height; top += bitsPerWord) {
+    int rows = height - top < bitsPerWord ? height - top : bitsPerWord;
+    for (int word = 0; word < rowSize; word++) {
+      int i = 0;
+      for (; i < rows; i++) {
+        int y = flipBefore ? height - 1 - top - i : top + i;
+        block[i] = from[y * rowSize + word];
+      }
+      for (; i < bitsPerWord; i++) {
+        block[i] = 0;
+      }
+      transposeBlock(block);
+      // Bits past the width become rows past the new height; drop them.
+      int left = word << logBits;
+      int columns = width - left < bitsPerWord ? width - left : bitsPerWord;
+      for (i = 0; i < columns; i++) {
+        int y = flipAfter ? width - 1 - left - i : left + i;
+        to[y * toRowSize + (top >> logBits)] = block[i];
+      }
+    }
+  }
+  return result;
+}
+
+Ref<BitMatrix> BitMatrix::rotate180() const {
+  Ref<BitMatrix> result(new BitMatrix(width, height));
+  // Reversing a row's words and their bits leaves its padding at the low
+  // end; shift it back out.
+  int padding = rowSize * bitsPerWord - width;
+  for (int y = 0; y < height; y++) {
+    int const* row = &bits[y * rowSize];
+    int* reversed = result->getRowBits(height - 1 - y);
+    unsigned int next = BitUtils::reverse(row[rowSize - 1]);
+    for (int i = 0; i < rowSize; i++) {
+      unsigned int current = next;
+      next = i + 1 < rowSize ? BitUtils::reverse(row[rowSize - 2 - i]) : 0;
+      reversed[i] = padding == 0 ? current : (current >> padding) | (next << (bitsPerWord - padding));
+    }
+  }
+  return result;
+}
+
 int BitMatrix::getWidth() const {
   return width;
 }
@@ -103,14 +272,9 @@ ArrayRef<int> BitMatrix::getTopLeftOnBit() const {
     return ArrayRef<int>();
   }
   int y = bitsOffset / rowSize;
-  int x = (bitsOffset % rowSize) << 5;
+  int x = (bitsOffset % rowSize) << logBits;
+  x += BitUtils::numberOfTrailingZeros(bits[bitsOffset]);
 
-  int theBits = bits[bitsOffset];
-  int bit = 0;
-  while ((theBits << (31-bit)) == 0) {
-    bit++;
-  }
-  x += bit;
   ArrayRef<int> res (2);
   res[0]=x;
   res[1]=y;
@@ -127,14 +291,8 @@ ArrayRef<int> BitMatrix::getBottomRightOnBit() const {
   }
 
   int y = bitsOffset / rowSize;
-  int x = (bitsOffset % rowSize) << 5;
-
-  int theBits = bits[bitsOffset];
-  int bit = 31;
-  while ((theBits >> bit) == 0) {
-    bit--;
-  }
-  x += bit;
+  int x = (bitsOffset % rowSize) << logBits;
+  x += bitsPerWord - 1 - BitUtils::numberOfLeadingZeros(bits[bitsOffset]);
 
   ArrayRef<int> res (2);
   res[0]=x;
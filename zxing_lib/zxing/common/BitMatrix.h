@@ -68,11 +68,40 @@ public:
     bits[offset] |= 1 << (x & bitsMask);
   }
 
+  // The words backing row y; column x is bit (x & bitsMask) of word
+  // (x >> logBits). Lets bulk writers fill whole words at a time.
+  int* getRowBits(int y) {
+    return &bits[y * rowSize];
+  }
+
   void flip(int x, int y);
   void clear();
   void setRegion(int left, int top, int width, int height);
+
+  /**
+   * Flips each bit of the region whose counterpart at the same position in
+   * mask is set. mask must be at least as large as the region's bottom
+   * right corner.
+   */
+  void xorRegion(int left, int top, int width, int height, BitMatrix const& mask);
+
+  /** Returns how many bits of the region are set. */
+  int countSetBits(int left, int top, int width, int height) const;
+
   Ref<BitArray> getRow(int y, Ref<BitArray> row);
 
+  /**
+   * Returns a new matrix holding this one mirrored about its main diagonal,
+   * so that its rows are this matrix's columns.
+   */
+  Ref<BitMatrix> transpose() const;
+
+  // Return new matrices holding this one turned by 90, 180 and 270 degrees
+  // counterclockwise. The first and last cost about as much as transpose().
+  Ref<BitMatrix> rotateCounterClockwise() const;
+  Ref<BitMatrix> rotate180() const;
+  Ref<BitMatrix> rotateClockwise() const;
+
   int getWidth() const;
   int getHeight() const;
 
@@ -84,6 +113,8 @@ public:
 
 private:
   inline void init(int, int);
+  Ref<BitMatrix> transpose(bool flipBefore, bool flipAfter) const;
+  void checkRegion(int left, int top, int width, int height) const;
 
   BitMatrix(const BitMatrix&);
   BitMatrix& operator =(const BitMatrix&);
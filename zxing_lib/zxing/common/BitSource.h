@@ -21,6 +21,7 @@
  */
 
 #include <zxing/common/Array.h>
+#include <zxing/common/Arena.h>
 
 namespace zxing {
 /**
@@ -32,7 +33,7 @@ namespace zxing {
  * @author srowen@google.com (Sean Owen)
  * @author christian.brunschen@gmail.com (Christian Brunschen)
  */
-class BitSource : public Counted {
+class BitSource : public Counted, public ArenaAllocated {
   typedef char byte;
 private:
   ArrayRef<byte> bytes_;
@@ -0,0 +1,114 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ZXING_COMMON_BITUTILS_H__
+#define __ZXING_COMMON_BITUTILS_H__
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace zxing {
+
+/*
+ * Word primitives for BitArray and BitMatrix, which store bits in 32-bit
+ * words. GCC and MSVC map them to single instructions where the target has
+ * them (CLZ on ARMv5 and later); other compilers get the bit tricks from
+ * Hacker's Delight that BitArray used before.
+ */
+class BitUtils {
+ private:
+  BitUtils();
+  ~BitUtils();
+ public:
+
+  // Java Integer.numberOfTrailingZeros; 32 for 0
+  static inline int numberOfTrailingZeros(unsigned int i) {
+    if (i == 0) {
+      return 32;
+    }
+#if defined(__GNUC__)
+    return __builtin_ctz(i);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, i);
+    return (int)index;
+#else
+    // HD, Figure 5-14
+    unsigned int y;
+    int n = 31;
+    y = i << 16; if (y != 0) { n = n - 16; i = y; }
+    y = i << 8; if (y != 0) { n = n - 8; i = y; }
+    y = i << 4; if (y != 0) { n = n - 4; i = y; }
+    y = i << 2; if (y != 0) { n = n - 2; i = y; }
+    return n - (int)((i << 1) >> 31);
+#endif
+  }
+
+  // Java Integer.numberOfLeadingZeros; 32 for 0
+  static inline int numberOfLeadingZeros(unsigned int i) {
+    if (i == 0) {
+      return 32;
+    }
+#if defined(__GNUC__)
+    return __builtin_clz(i);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, i);
+    return 31 - (int)index;
+#else
+    // HD, Figure 5-6
+    int n = 1;
+    if ((i >> 16) == 0) { n += 16; i <<= 16; }
+    if ((i >> 24) == 0) { n += 8; i <<= 8; }
+    if ((i >> 28) == 0) { n += 4; i <<= 4; }
+    if ((i >> 30) == 0) { n += 2; i <<= 2; }
+    return n - (int)(i >> 31);
+#endif
+  }
+
+  // Java Integer.bitCount
+  static inline int bitCount(unsigned int i) {
+#if defined(__GNUC__)
+    return __builtin_popcount(i);
+#else
+    // HD, Figure 5-2
+    i = i - ((i >> 1) & 0x55555555);
+    i = (i & 0x33333333) + ((i >> 2) & 0x33333333);
+    i = (i + (i >> 4)) & 0x0f0f0f0f;
+    return (int)((i * 0x01010101) >> 24);
+#endif
+  }
+
+  // Java Integer.reverse
+  static inline unsigned int reverse(unsigned int i) {
+    // HD, Figure 7-1
+    i = (i & 0x55555555) << 1 | ((i >> 1) & 0x55555555);
+    i = (i & 0x33333333) << 2 | ((i >> 2) & 0x33333333);
+    i = (i & 0x0f0f0f0f) << 4 | ((i >> 4) & 0x0f0f0f0f);
+    i = (i << 24) | ((i & 0xff00) << 8) | ((i >> 8) & 0xff00) | (i >> 24);
+    return i;
+  }
+
+  // The word with bits from through to set, 0 <= from <= to <= 31
+  static inline unsigned int rangeMask(int from, int to) {
+    return (~0u << from) & (~0u >> (31 - to));
+  }
+};
+
+}
+
+#endif
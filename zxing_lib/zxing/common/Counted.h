@@ -19,31 +19,132 @@
  */
 
 #include <iostream>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Reference counts are plain integers unless an object is marked shared,
+ * in which case they are updated atomically (relaxed increments,
+ * acquire-release decrements). Define ZXING_ATOMIC_REFCOUNT to make every
+ * object's count atomic instead.
+ */
+#if !defined(__GNUC__) && !defined(_MSC_VER) && defined(ZXING_ATOMIC_REFCOUNT)
+#error "ZXING_ATOMIC_REFCOUNT needs GCC/Clang atomic builtins or MSVC interlocked intrinsics"
+#endif
 
 namespace zxing {
 
+namespace detail {
+  inline void atomicIncrement(unsigned int *count) {
+#if defined(__GNUC__)
+    __atomic_fetch_add(count, 1u, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+    _InterlockedIncrement(reinterpret_cast<long volatile *>(count));
+#else
+    ++*count;
+#endif
+  }
+  inline unsigned int atomicDecrement(unsigned int *count) {
+#if defined(__GNUC__)
+    return __atomic_sub_fetch(count, 1u, __ATOMIC_ACQ_REL);
+#elif defined(_MSC_VER)
+    return (unsigned int)_InterlockedDecrement(reinterpret_cast<long volatile *>(count));
+#else
+    return --*count;
+#endif
+  }
+
+  // For tables built on first use and shared by all threads afterwards:
+  // loadShared() reads the slot, publishShared() stores value unless another
+  // thread got there first and returns whichever ends up in the slot.
+  template<typename T> inline T *loadShared(T * const *slot) {
+#if defined(__GNUC__)
+    return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+#else
+    return *(T * const volatile *)slot;
+#endif
+  }
+  template<typename T> inline T *publishShared(T **slot, T *value) {
+#if defined(__GNUC__)
+    T *expected = 0;
+    if (__atomic_compare_exchange_n(slot, &expected, value, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      return value;
+    }
+    return expected;
+#elif defined(_MSC_VER)
+    void *previous = _InterlockedCompareExchangePointer(reinterpret_cast<void * volatile *>(slot), value, 0);
+    return previous ? static_cast<T *>(previous) : value;
+#else
+    if (!*slot) {
+      *slot = value;
+    }
+    return *slot;
+#endif
+  }
+}
+
 /* base class for reference-counted objects */
 class Counted {
 private:
   unsigned int count_;
+#if !defined(ZXING_ATOMIC_REFCOUNT)
+  bool shared_;
+#endif
+
+  /*
+   * Deletes this object once the last reference is gone. It is kept out of
+   * line so that the delete always goes through the virtual destructor,
+   * and so the operator delete of the most derived class: ArenaAllocated
+   * types have their own. Inlined into a caller that also holds the
+   * matching new, the compiler may guess a different destructor and warn
+   * of mismatched new and delete.
+   */
+  void destroy();
 public:
   Counted() :
-      count_(0) {
+      count_(0)
+#if !defined(ZXING_ATOMIC_REFCOUNT)
+      , shared_(false)
+#endif
+  {
   }
   virtual ~Counted() {
   }
   Counted *retain() {
-    count_++;
+    if (isShared()) {
+      detail::atomicIncrement(&count_);
+    } else {
+      count_++;
+    }
     return this;
   }
   void release() {
-    count_--;
-    if (count_ == 0) {
+    unsigned int count = isShared() ? detail::atomicDecrement(&count_) : --count_;
+    if (count == 0) {
       count_ = 0xDEADF001;
-      delete this;
+      destroy();
     }
   }
 
+  /*
+   * Switches this object to atomic reference counting, so Refs to it may be
+   * copied and dropped on several threads at once. Call it before the
+   * object is handed to another thread. Objects it refers to are not
+   * affected and need marking themselves if they are shared too.
+   */
+  void markShared() {
+#if !defined(ZXING_ATOMIC_REFCOUNT)
+    shared_ = true;
+#endif
+  }
+  bool isShared() const {
+#if defined(ZXING_ATOMIC_REFCOUNT)
+    return true;
+#else
+    return shared_;
+#endif
+  }
 
   /* return the current count for denugging purposes or similar */
   int count() const {
@@ -71,6 +172,20 @@ public:
     reset(other.object_);
   }
 
+#if __cplusplus >= 201103L
+  // Moves hand the reference over without touching the count.
+  Ref(Ref &&other) :
+      object_(other.object_) {
+    other.object_ = 0;
+  }
+
+  template<class Y>
+  Ref(Ref<Y> &&other) :
+      object_(other.object_) {
+    other.object_ = 0;
+  }
+#endif
+
   ~Ref() {
     if (object_) {
       object_->release();
@@ -95,6 +210,19 @@ public:
     reset(other.object_);
     return *this;
   }
+#if __cplusplus >= 201103L
+  Ref& operator=(Ref &&other) {
+    if (this != &other) {
+      T *old = object_;
+      object_ = other.object_;
+      other.object_ = 0;
+      if (old) {
+        old->release();
+      }
+    }
+    return *this;
+  }
+#endif
   Ref& operator=(T* o) {
     reset(o);
     return *this;
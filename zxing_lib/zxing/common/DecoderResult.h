@@ -21,13 +21,14 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <zxing/common/Array.h>
 #include <string>
 #include <zxing/common/Str.h>
 
 namespace zxing {
 
-class DecoderResult : public Counted {
+class DecoderResult : public Counted, public ArenaAllocated {
 private:
   ArrayRef<char> rawBytes_;
   Ref<String> text_;
@@ -21,13 +21,14 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <zxing/common/Array.h>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/ResultPoint.h>
 
 namespace zxing {
 
-class DetectorResult : public Counted {
+class DetectorResult : public Counted, public ArenaAllocated {
 private:
   Ref<BitMatrix> bits_;
   ArrayRef< Ref<ResultPoint> > points_;
@@ -36,14 +36,25 @@ namespace {
   const int LUMINANCE_BITS = 5;
   const int LUMINANCE_SHIFT = 8 - LUMINANCE_BITS;
   const int LUMINANCE_BUCKETS = 1 << LUMINANCE_BITS;
-  const ArrayRef<char> EMPTY (0);
+  // Every binarizer starts out sharing this, possibly on different threads.
+  ArrayRef<char> makeEmpty() {
+    ArrayRef<char> empty (0);
+    empty->markShared();
+    return empty;
+  }
+  const ArrayRef<char> EMPTY (makeEmpty());
 }
 
 GlobalHistogramBinarizer::GlobalHistogramBinarizer(Ref<LuminanceSource> source) 
-  : Binarizer(source), luminances(EMPTY), buckets(LUMINANCE_BUCKETS) {}
+  : Binarizer(source), luminances(EMPTY), buckets(LUMINANCE_BUCKETS), matrixValid_(false) {}
 
 GlobalHistogramBinarizer::~GlobalHistogramBinarizer() {}
 
+void GlobalHistogramBinarizer::reset() {
+  Binarizer::reset();
+  matrixValid_ = false;
+}
+
 void GlobalHistogramBinarizer::initArrays(int luminanceSize) {
   if (luminances->size() < luminanceSize) {
     luminances = ArrayRef<char>(luminanceSize);
@@ -96,10 +107,20 @@ Ref<BitArray> GlobalHistogramBinarizer::getBlackRow(int y, Ref<BitArray> row) {
 }
  
 Ref<BitMatrix> GlobalHistogramBinarizer::getBlackMatrix() {
+  // Calculated once like HybridBinarizer's; after a reset() the previous
+  // frame's matrix is recycled.
+  if (matrixValid_) {
+    return matrix_;
+  }
   LuminanceSource& source = *getLuminanceSource();
   int width = source.getWidth();
   int height = source.getHeight();
-  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  Ref<BitMatrix> matrix(matrix_);
+  if (!matrix || matrix->getWidth() != width || matrix->getHeight() != height) {
+    matrix = new BitMatrix(width, height);
+  } else {
+    matrix->clear();
+  }
 
   // Quickly calculates the histogram by sampling four rows from the image.
   // This proved to be more robust on the blackbox tests than sampling a
@@ -129,6 +150,8 @@ Ref<BitMatrix> GlobalHistogramBinarizer::getBlackMatrix() {
     }
   }
   
+  matrix_ = matrix;
+  matrixValid_ = true;
   return matrix;
 }
 
@@ -31,12 +31,15 @@ class GlobalHistogramBinarizer : public Binarizer {
 private:
   ArrayRef<char> luminances;
   ArrayRef<int> buckets;
+  Ref<BitMatrix> matrix_;
+  bool matrixValid_;
 public:
   GlobalHistogramBinarizer(Ref<LuminanceSource> source);
   virtual ~GlobalHistogramBinarizer();
 		
   virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
   virtual Ref<BitMatrix> getBlackMatrix();
+  virtual void reset();
   static int estimateBlackPoint(ArrayRef<int> const& buckets);
   Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
 private:
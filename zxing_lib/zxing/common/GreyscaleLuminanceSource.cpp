@@ -57,18 +57,27 @@ ArrayRef<char> GreyscaleLuminanceSource::getRow(int y, ArrayRef<char> row) const
 }
 
 ArrayRef<char> GreyscaleLuminanceSource::getMatrix() const {
+  // If the caller asks for the entire underlying image, save the copy and
+  // give them the original data. Several binarizer passes share one plane
+  // this way.
+  if (left_ == 0 && top_ == 0 && dataWidth_ == getWidth() && dataHeight_ == getHeight()) {
+    return greyData_;
+  }
   int size = getWidth() * getHeight();
   ArrayRef<char> result (size);
-  if (left_ == 0 && top_ == 0 && dataWidth_ == getWidth() && dataHeight_ == getHeight()) {
-    memcpy(&result[0], &greyData_[0], size);
-  } else {
-    for (int row = 0; row < getHeight(); row++) {
-      memcpy(&result[row * getWidth()], &greyData_[(top_ + row) * dataWidth_ + left_], getWidth());
-    }
+  for (int row = 0; row < getHeight(); row++) {
+    memcpy(&result[row * getWidth()], &greyData_[(top_ + row) * dataWidth_ + left_], getWidth());
   }
   return result;
 }
 
+Ref<LuminanceSource> GreyscaleLuminanceSource::crop(int left, int top, int width, int height) const {
+  return Ref<LuminanceSource>(
+      new GreyscaleLuminanceSource(greyData_,
+                                   dataWidth_, dataHeight_,
+                                   left_ + left, top_ + top, width, height));
+}
+
 Ref<LuminanceSource> GreyscaleLuminanceSource::rotateCounterClockwise() const {
   // Intentionally flip the left, top, width, and height arguments as
   // needed. dataWidth and dataHeight are always kept unrotated.
@@ -39,8 +39,17 @@ public:
                            int top, int width, int height);
 
   ArrayRef<char> getRow(int y, ArrayRef<char> row) const;
+
+  // When the source covers all of greyData, this returns greyData itself
+  // rather than a copy, so callers must treat the result as read-only.
   ArrayRef<char> getMatrix() const;
 
+  bool isCropSupported() const {
+    return true;
+  }
+
+  Ref<LuminanceSource> crop(int left, int top, int width, int height) const;
+
   bool isRotateSupported() const {
     return true;
   }
@@ -21,9 +21,16 @@
 #include <zxing/common/GridSampler.h>
 #include <zxing/common/PerspectiveTransform.h>
 #include <zxing/ReaderException.h>
-#include <iostream>
 #include <sstream>
 
+#if !defined(ZXING_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ZXING_SAMPLER_NEON 1
+#include <arm_neon.h>
+#elif !defined(ZXING_NO_SIMD) && defined(__SSE2__)
+#define ZXING_SAMPLER_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace zxing {
 using namespace std;
 
@@ -32,49 +39,195 @@ GridSampler GridSampler::gridSampler;
 GridSampler::GridSampler() {
 }
 
-Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform) {
-  Ref<BitMatrix> bits(new BitMatrix(dimension));
-  vector<float> points(dimension << 1, (const float)0.0f);
-  for (int y = 0; y < dimension; y++) {
-    int max = points.size();
-    float yValue = (float)y + 0.5f;
-    for (int x = 0; x < max; x += 2) {
-      points[x] = (float)(x >> 1) + 0.5f;
-      points[x + 1] = yValue;
+namespace {
+  /*
+   * One row of the grid. The terms of the transform that only depend on the
+   * row are worked out once; the rest are evaluated per point in the same
+   * order as PerspectiveTransform::transformPoints(), rather than stepped
+   * along the row, so samples come out exactly as before. The SSE2 lanes
+   * divide and so round like the scalar code; 32-bit NEON has no divide and
+   * may differ in the last bit, which only matters for a point within
+   * rounding of a pixel boundary.
+   */
+  struct SampleRow {
+    float a11, a12, a13;
+    float a31, a32, a33;
+    // a21 * y, a22 * y and a23 * y
+    float x, y, d;
+
+    float denominator(float column) const {
+      return a13 * column + d + a33;
+    }
+    float getX(float column, float denominator) const {
+      return (a11 * column + x + a31) / denominator;
+    }
+    float getY(float column, float denominator) const {
+      return (a12 * column + y + a32) / denominator;
+    }
+  };
+
+  inline bool inside(float x, float y, int width, int height) {
+    return x >= 0.0f && x <= float(width - 1) && y >= 0.0f && y <= float(height - 1);
+  }
+
+  /*
+   * The transform takes the row to a line segment as long as the denominator
+   * keeps its sign, so when both ends lie in the image every point between
+   * them does too. The ends may lie anywhere in [0, width - 1] by
+   * [0, height - 1]; a point between them that rounding carries slightly
+   * past an end is still truncated onto the edge pixel.
+   */
+  bool rowInside(SampleRow const& row, int dimension, int width, int height) {
+    float first = 0.5f;
+    float last = float(dimension) - 0.5f;
+    float firstD = row.denominator(first);
+    float lastD = row.denominator(last);
+    if (!((firstD > 0.0f && lastD > 0.0f) || (firstD < 0.0f && lastD < 0.0f))) {
+      return false;
+    }
+    return inside(row.getX(first, firstD), row.getY(first, firstD), width, height) &&
+      inside(row.getX(last, lastD), row.getY(last, lastD), width, height);
+  }
+
+  // Image coordinates of columns [column, column + 4).
+  inline void project4(SampleRow const& row, int column, int* xs, int* ys) {
+#if defined(ZXING_SAMPLER_NEON)
+    static const float LANES[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+    float32x4_t c = vaddq_f32(vdupq_n_f32(float(column)), vld1q_f32(LANES));
+    float32x4_t d = vaddq_f32(vmlaq_n_f32(vdupq_n_f32(row.d), c, row.a13), vdupq_n_f32(row.a33));
+    float32x4_t x = vaddq_f32(vmlaq_n_f32(vdupq_n_f32(row.x), c, row.a11), vdupq_n_f32(row.a31));
+    float32x4_t y = vaddq_f32(vmlaq_n_f32(vdupq_n_f32(row.y), c, row.a12), vdupq_n_f32(row.a32));
+#if defined(__aarch64__)
+    vst1q_s32(xs, vcvtq_s32_f32(vdivq_f32(x, d)));
+    vst1q_s32(ys, vcvtq_s32_f32(vdivq_f32(y, d)));
+#else
+    // No vector divide before ARMv8; two Newton-Raphson steps bring the
+    // estimate to full single precision, though not always the same
+    // rounding as a divide.
+    float32x4_t inverse = vrecpeq_f32(d);
+    inverse = vmulq_f32(vrecpsq_f32(d, inverse), inverse);
+    inverse = vmulq_f32(vrecpsq_f32(d, inverse), inverse);
+    vst1q_s32(xs, vcvtq_s32_f32(vmulq_f32(x, inverse)));
+    vst1q_s32(ys, vcvtq_s32_f32(vmulq_f32(y, inverse)));
+#endif
+#elif defined(ZXING_SAMPLER_SSE2)
+    __m128 c = _mm_add_ps(_mm_cvtepi32_ps(_mm_set1_epi32(column)), _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f));
+    __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(row.a13), c), _mm_set1_ps(row.d)),
+                          _mm_set1_ps(row.a33));
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(row.a11), c), _mm_set1_ps(row.x)),
+                          _mm_set1_ps(row.a31));
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(row.a12), c), _mm_set1_ps(row.y)),
+                          _mm_set1_ps(row.a32));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(xs), _mm_cvttps_epi32(_mm_div_ps(x, d)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ys), _mm_cvttps_epi32(_mm_div_ps(y, d)));
+#else
+    for (int k = 0; k < 4; k++) {
+      float c = float(column + k) + 0.5f;
+      float d = row.denominator(c);
+      xs[k] = (int)row.getX(c, d);
+      ys[k] = (int)row.getY(c, d);
+    }
+#endif
+  }
+
+  // Samples a row that rowInside() accepted into words, 32 modules a word.
+  void sampleInside(BitMatrix const& image, SampleRow const& row, int dimension, int* words) {
+    int xs[4];
+    int ys[4];
+    unsigned int word = 0;
+    int x = 0;
+    for (; x + 4 <= dimension; x += 4) {
+      project4(row, x, xs, ys);
+      for (int k = 0; k < 4; k++) {
+        word |= (unsigned int)image.get(xs[k], ys[k]) << ((x + k) & 31);
+      }
+      if (((x + 4) & 31) == 0) {
+        words[x >> 5] = (int)word;
+        word = 0;
+      }
+    }
+    for (; x < dimension; x++) {
+      float c = float(x) + 0.5f;
+      float d = row.denominator(c);
+      word |= (unsigned int)image.get((int)row.getX(c, d), (int)row.getY(c, d)) << (x & 31);
+    }
+    if ((dimension & 31) != 0) {
+      words[(dimension - 1) >> 5] = (int)word;
     }
-    transform->transformPoints(points);
-    checkAndNudgePoints(image, points);
-    for (int x = 0; x < max; x += 2) {
-      if (image->get((int)points[x], (int)points[x + 1])) {
-        bits->set(x >> 1, y);
+  }
+
+  void throwOutOfBounds(int x, int y) {
+    ostringstream s;
+    s << "Transformed point out of bounds at " << x << "," << y;
+    throw ReaderException(s.str().c_str());
+  }
+
+  /*
+   * Samples a row that runs up to or past the edge of the image, checking
+   * every point like checkAndNudgePoints(): points just off the edge are
+   * nudged back on, and any further out fail the whole sample.
+   */
+  void sampleChecked(BitMatrix const& image, SampleRow const& row, int dimension, int* words) {
+    int width = image.getWidth();
+    int height = image.getHeight();
+    unsigned int word = 0;
+    for (int x = 0; x < dimension; x++) {
+      float c = float(x) + 0.5f;
+      float d = row.denominator(c);
+      int px = (int)row.getX(c, d);
+      int py = (int)row.getY(c, d);
+      if (px < -1 || px > width || py < -1 || py > height) {
+        throwOutOfBounds(px, py);
+      }
+      px = px < 0 ? 0 : px >= width ? width - 1 : px;
+      py = py < 0 ? 0 : py >= height ? height - 1 : py;
+      word |= (unsigned int)image.get(px, py) << (x & 31);
+      if ((x & 31) == 31 || x == dimension - 1) {
+        words[x >> 5] = (int)word;
+        word = 0;
       }
     }
   }
-  return bits;
 }
 
-Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimensionX, int dimensionY, Ref<PerspectiveTransform> transform) {
+Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> const& image, int dimension, Ref<PerspectiveTransform> const& transform) {
+  return sampleGrid(image, dimension, dimension, transform);
+}
+
+/**
+ * Samples the centre of every module, a row at a time. Rows whose ends both
+ * land inside the image, nearly all of them, are sampled without further
+ * bounds checks, four points at a time where the target has vector units;
+ * define ZXING_NO_SIMD to force the scalar code.
+ */
+Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> const& image, int dimensionX, int dimensionY, Ref<PerspectiveTransform> const& transform) {
   Ref<BitMatrix> bits(new BitMatrix(dimensionX, dimensionY));
-  vector<float> points(dimensionX << 1, (const float)0.0f);
+  PerspectiveTransform const& t = *transform;
+  BitMatrix const& source = *image;
+  int width = source.getWidth();
+  int height = source.getHeight();
+  SampleRow row;
+  row.a11 = t.a11;
+  row.a12 = t.a12;
+  row.a13 = t.a13;
+  row.a31 = t.a31;
+  row.a32 = t.a32;
+  row.a33 = t.a33;
   for (int y = 0; y < dimensionY; y++) {
-    int max = points.size();
     float yValue = (float)y + 0.5f;
-    for (int x = 0; x < max; x += 2) {
-      points[x] = (float)(x >> 1) + 0.5f;
-      points[x + 1] = yValue;
-    }
-    transform->transformPoints(points);
-    checkAndNudgePoints(image, points);
-    for (int x = 0; x < max; x += 2) {
-      if (image->get((int)points[x], (int)points[x + 1])) {
-        bits->set(x >> 1, y);
-      }
+    row.x = t.a21 * yValue;
+    row.y = t.a22 * yValue;
+    row.d = t.a23 * yValue;
+    if (rowInside(row, dimensionX, width, height)) {
+      sampleInside(source, row, dimensionX, bits->getRowBits(y));
+    } else {
+      sampleChecked(source, row, dimensionX, bits->getRowBits(y));
     }
   }
   return bits;
 }
 
-Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimension, float p1ToX, float p1ToY, float p2ToX,
+Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> const& image, int dimension, float p1ToX, float p1ToY, float p2ToX,
                                        float p2ToY, float p3ToX, float p3ToY, float p4ToX, float p4ToY, float p1FromX, float p1FromY, float p2FromX,
                                        float p2FromY, float p3FromX, float p3FromY, float p4FromX, float p4FromY) {
   Ref<PerspectiveTransform> transform(PerspectiveTransform::quadrilateralToQuadrilateral(p1ToX, p1ToY, p2ToX, p2ToY,
@@ -84,7 +237,7 @@ Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimension, floa
 
 }
 
-void GridSampler::checkAndNudgePoints(Ref<BitMatrix> image, vector<float> &points) {
+void GridSampler::checkAndNudgePoints(Ref<BitMatrix> const& image, vector<float> &points) {
   int width = image->getWidth();
   int height = image->getHeight();
 
@@ -97,9 +250,7 @@ void GridSampler::checkAndNudgePoints(Ref<BitMatrix> image, vector<float> &point
     int x = (int)points[offset];
     int y = (int)points[offset + 1];
     if (x < -1 || x > width || y < -1 || y > height) {
-      ostringstream s;
-      s << "Transformed point out of bounds at " << x << "," << y;
-      throw ReaderException(s.str().c_str());
+      throwOutOfBounds(x, y);
     }
 
     if (x == -1) {
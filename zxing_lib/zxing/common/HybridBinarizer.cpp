@@ -21,6 +21,15 @@
 #include <zxing/common/HybridBinarizer.h>
 
 #include <zxing/common/IllegalArgumentException.h>
+#include <string.h>
+
+#if !defined(ZXING_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ZXING_BINARIZER_NEON 1
+#include <arm_neon.h>
+#elif !defined(ZXING_NO_SIMD) && defined(__SSE2__)
+#define ZXING_BINARIZER_SSE2 1
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 using namespace zxing;
@@ -33,16 +42,28 @@ namespace {
 }
 
 HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source) :
-  GlobalHistogramBinarizer(source), matrix_(NULL), cached_row_(NULL) {
+  GlobalHistogramBinarizer(source), matrix_(NULL), matrixValid_(false), statsValid_(false),
+  cached_row_(NULL) {
+}
+
+HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source, Ref<ThreadPool> pool) :
+  GlobalHistogramBinarizer(source), matrix_(NULL), matrixValid_(false), statsValid_(false),
+  cached_row_(NULL), pool_(pool) {
 }
 
 HybridBinarizer::~HybridBinarizer() {
 }
 
+void HybridBinarizer::reset() {
+  GlobalHistogramBinarizer::reset();
+  matrixValid_ = false;
+  statsValid_ = false;
+}
+
 
 Ref<Binarizer>
 HybridBinarizer::createBinarizer(Ref<LuminanceSource> source) {
-  return Ref<Binarizer> (new HybridBinarizer(source));
+  return Ref<Binarizer> (new HybridBinarizer(source, pool_));
 }
 
 
@@ -52,7 +73,7 @@ HybridBinarizer::createBinarizer(Ref<LuminanceSource> source) {
  * profiling easier, and not doing heavy lifting when callers don't expect it.
  */
 Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
-  if (matrix_) {
+  if (matrixValid_) {
     return matrix_;
   }
   LuminanceSource& source = *getLuminanceSource();
@@ -71,7 +92,13 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
     ArrayRef<int> blackPoints =
       calculateBlackPoints(luminances, subWidth, subHeight, width, height);
 
-    Ref<BitMatrix> newMatrix (new BitMatrix(width, height));
+    // After a reset() the matrix from the previous frame is recycled.
+    Ref<BitMatrix> newMatrix (matrix_);
+    if (!newMatrix || newMatrix->getWidth() != width || newMatrix->getHeight() != height) {
+      newMatrix = new BitMatrix(width, height);
+    } else {
+      newMatrix->clear();
+    }
     calculateThresholdForBlock(luminances,
                                subWidth,
                                subHeight,
@@ -84,6 +111,7 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
     // If the image is too small, fall back to the global histogram approach.
     matrix_ = GlobalHistogramBinarizer::getBlackMatrix();
   }
+  matrixValid_ = true;
   return matrix_;
 }
 
@@ -91,125 +119,415 @@ namespace {
   inline int cap(int value, int min, int max) {
     return value < min ? min : value > max ? max : value;
   }
+
+  /*
+   * Sets bit x of words for every pixel at or below thresholds[x]. Whole
+   * 32-pixel words are built in registers and ORed into the matrix once, so
+   * overlapping blocks at the right and bottom edges still combine. The vector
+   * paths are picked from the target flags; define ZXING_NO_SIMD to force the
+   * scalar one.
+   */
+  void thresholdRow(const unsigned char* pixels,
+                    const unsigned char* thresholds,
+                    int width,
+                    int* words) {
+    int x = 0;
+#if defined(ZXING_BINARIZER_NEON)
+    static const uint8_t BIT_WEIGHTS[16] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+    };
+    const uint8x16_t weights = vld1q_u8(BIT_WEIGHTS);
+    for (; x + 32 <= width; x += 32) {
+      uint8x16_t b0 = vandq_u8(vcleq_u8(vld1q_u8(pixels + x), vld1q_u8(thresholds + x)), weights);
+      uint8x16_t b1 = vandq_u8(vcleq_u8(vld1q_u8(pixels + x + 16), vld1q_u8(thresholds + x + 16)), weights);
+      // Three pairwise adds fold each run of eight weighted lanes into a byte.
+      uint8x8_t s = vpadd_u8(vpadd_u8(vget_low_u8(b0), vget_high_u8(b0)),
+                             vpadd_u8(vget_low_u8(b1), vget_high_u8(b1)));
+      s = vpadd_u8(s, s);
+      words[x >> 5] |= (int)vget_lane_u32(vreinterpret_u32_u8(s), 0);
+    }
+#elif defined(ZXING_BINARIZER_SSE2)
+    for (; x + 32 <= width; x += 32) {
+      __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + x));
+      __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + x + 16));
+      __m128i t0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(thresholds + x));
+      __m128i t1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(thresholds + x + 16));
+      // pixel <= threshold exactly when min(pixel, threshold) == pixel
+      unsigned m0 = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(p0, t0), p0));
+      unsigned m1 = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(p1, t1), p1));
+      words[x >> 5] |= (int)(m0 | (m1 << 16));
+    }
+#endif
+    while (x < width) {
+      int end = x + 32 < width ? x + 32 : width;
+      unsigned word = 0;
+      for (int i = x; i < end; i++) {
+        word |= (unsigned)(pixels[i] <= thresholds[i]) << (i & 31);
+      }
+      words[x >> 5] |= (int)word;
+      x = end;
+    }
+  }
+
+  // Thresholds block rows [firstRow, endRow) into matrix. columnSums holds
+  // subWidth ints and thresholds width bytes of scratch.
+  void thresholdBlockRows(const unsigned char* pixels,
+                          int width,
+                          int height,
+                          int subWidth,
+                          int subHeight,
+                          const int* blackPoints,
+                          BitMatrix& matrix,
+                          int firstRow,
+                          int endRow,
+                          int* columnSums,
+                          unsigned char* thresholds) {
+    int maxXOffset = width - BLOCK_SIZE;
+    int maxYOffset = height - BLOCK_SIZE;
+    int lastTop = -1;
+    for (int y = firstRow; y < endRow; y++) {
+      int yoffset = y << BLOCK_SIZE_POWER;
+      if (yoffset > maxYOffset) {
+        yoffset = maxYOffset;
+      }
+      // Sum the 5x5 black point neighbourhood as five column sums and a
+      // sliding window, rather than 25 loads per block.
+      int top = cap(y, 2, subHeight - 3);
+      if (top != lastTop) {
+        const int *blackRow = &blackPoints[(top - 2) * subWidth];
+        for (int x = 0; x < subWidth; x++) {
+          columnSums[x] = blackRow[x] +
+            blackRow[x + subWidth] +
+            blackRow[x + 2 * subWidth] +
+            blackRow[x + 3 * subWidth] +
+            blackRow[x + 4 * subWidth];
+        }
+        lastTop = top;
+      }
+      int sum = columnSums[0] + columnSums[1] + columnSums[2] + columnSums[3] + columnSums[4];
+      for (int x = 0; x < subWidth; x++) {
+        int left = cap(x, 2, subWidth - 3);
+        if (x > 2 && left == x) {
+          sum += columnSums[left + 2] - columnSums[left - 3];
+        }
+        int average = sum / 25;
+        int xoffset = x << BLOCK_SIZE_POWER;
+        if (xoffset <= maxXOffset) {
+          memset(thresholds + xoffset, average, BLOCK_SIZE);
+        } else {
+          // The last block overlaps its neighbour when the width is not a
+          // multiple of BLOCK_SIZE. A pixel there is black if it passes either
+          // block's threshold, i.e. the larger of the two.
+          for (int i = maxXOffset; i < xoffset; i++) {
+            if (thresholds[i] < average) {
+              thresholds[i] = (unsigned char)average;
+            }
+          }
+          memset(thresholds + xoffset, average, width - xoffset);
+        }
+      }
+      for (int yy = 0; yy < BLOCK_SIZE; yy++) {
+        thresholdRow(pixels + (yoffset + yy) * width,
+                     thresholds,
+                     width,
+                     matrix.getRowBits(yoffset + yy));
+      }
+    }
+  }
+
+  /*
+   * One band of block rows per thread. When the height is not a multiple of
+   * BLOCK_SIZE the last block row shares pixel rows with the one above, so it
+   * is left out of the split and done by the band that ends next to it;
+   * no two threads then write the same matrix words. Each thread works in its
+   * own slice of the scratch, which the caller sizes beforehand.
+   */
+  class ThresholdJob : public ThreadPool::Job {
+  private:
+    const unsigned char* pixels_;
+    int width_;
+    int height_;
+    int subWidth_;
+    int subHeight_;
+    const int* blackPoints_;
+    BitMatrix& matrix_;
+    int* columnSums_;
+    unsigned char* thresholds_;
+  public:
+    ThresholdJob(const unsigned char* pixels, int width, int height, int subWidth, int subHeight,
+                 const int* blackPoints, BitMatrix& matrix,
+                 int* columnSums, unsigned char* thresholds) :
+      pixels_(pixels), width_(width), height_(height), subWidth_(subWidth), subHeight_(subHeight),
+      blackPoints_(blackPoints), matrix_(matrix), columnSums_(columnSums), thresholds_(thresholds) {
+    }
+
+    int bandedRows() const {
+      return height_ >> BLOCK_SIZE_POWER;
+    }
+
+    virtual void run(int begin, int end, int thread) {
+      if (end == bandedRows()) {
+        end = subHeight_;
+      }
+      thresholdBlockRows(pixels_, width_, height_, subWidth_, subHeight_, blackPoints_, matrix_,
+                         begin, end, columnSums_ + thread * subWidth_,
+                         thresholds_ + thread * width_);
+    }
+  };
 }
 
 void
-HybridBinarizer::calculateThresholdForBlock(ArrayRef<char> luminances,
+HybridBinarizer::calculateThresholdForBlock(ArraySpan<char> luminances,
                                             int subWidth,
                                             int subHeight,
                                             int width,
                                             int height,
-                                            ArrayRef<int> blackPoints,
+                                            ArraySpan<int> blackPoints,
                                             Ref<BitMatrix> const& matrix) {
-  for (int y = 0; y < subHeight; y++) {
-    int yoffset = y << BLOCK_SIZE_POWER;
-    int maxYOffset = height - BLOCK_SIZE;
-    if (yoffset > maxYOffset) {
-      yoffset = maxYOffset;
+  const unsigned char* pixels = reinterpret_cast<const unsigned char*>(luminances.data());
+  int threads = pool_ ? pool_->getThreadCount() : 1;
+  if (!columnSums_ || columnSums_->size() != threads * subWidth) {
+    columnSums_ = ArrayRef<int>(threads * subWidth);
+  }
+  if (!thresholds_ || thresholds_->size() != threads * width) {
+    thresholds_ = ArrayRef<char>(threads * width);
+  }
+  ThresholdJob job(pixels, width, height, subWidth, subHeight, blackPoints.data(), *matrix,
+                   &columnSums_[0], reinterpret_cast<unsigned char*>(&thresholds_[0]));
+  if (threads > 1) {
+    pool_->parallelFor(job.bandedRows(), job);
+  } else {
+    job.run(0, subHeight, 0);
+  }
+}
+
+namespace {
+  const int MIN_DYNAMIC_RANGE = 24;
+
+  inline int getBlackPointFromNeighbors(ArraySpan<int> blackPoints, int subWidth, int x, int y) {
+    return (blackPoints[(y-1)*subWidth+x] +
+            2*blackPoints[y*subWidth+x-1] +
+            blackPoints[(y-1)*subWidth+x-1]) >> 2;
+  }
+
+  /*
+   * Block statistics are packed as sum << 16 | max << 8 | min; the sum of an
+   * 8x8 block is at most 64 * 255, so this always fits.
+   */
+  inline int packStats(int sum, int min, int max) {
+    return (sum << 16) | (max << 8) | min;
+  }
+
+  // Once the dynamic range is met the remaining rows only add to the sum.
+  // min and max are then partial, but the vector versions, which always
+  // cover the whole block, give the same MIN_DYNAMIC_RANGE outcome since the
+  // range can only grow.
+  inline int blockStats(const unsigned char* pixels, int stride) {
+    int sum = 0;
+    int min = 0xFF;
+    int max = 0;
+    for (int yy = 0; yy < BLOCK_SIZE; yy++, pixels += stride) {
+      for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+        int pixel = pixels[xx];
+        sum += pixel;
+        // still looking for good contrast
+        min = pixel < min ? pixel : min;
+        max = pixel > max ? pixel : max;
+      }
+
+      // short-circuit min/max tests once dynamic range is met
+      if (max - min > MIN_DYNAMIC_RANGE) {
+        // finish the rest of the rows quickly
+        for (yy++, pixels += stride; yy < BLOCK_SIZE; yy++, pixels += stride) {
+          for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+            sum += pixels[xx];
+          }
+        }
+        break;
+      }
     }
-    for (int x = 0; x < subWidth; x++) {
+    return packStats(sum, min, max);
+  }
+
+#if defined(ZXING_BINARIZER_NEON)
+  // Stats of two horizontally adjacent blocks, one per 8-lane half.
+  inline void blockPairStats(const unsigned char* pixels, int stride, int* stats) {
+    uint8x16_t row = vld1q_u8(pixels);
+    uint8x16_t lo = row;
+    uint8x16_t hi = row;
+    uint16x8_t acc = vpaddlq_u8(row);
+    for (int yy = 1; yy < BLOCK_SIZE; yy++) {
+      pixels += stride;
+      row = vld1q_u8(pixels);
+      lo = vminq_u8(lo, row);
+      hi = vmaxq_u8(hi, row);
+      acc = vpadalq_u8(acc, row);
+    }
+    uint64x2_t total = vpaddlq_u32(vpaddlq_u16(acc));
+    // Three pairwise steps leave each half's extreme in lanes 0 and 1.
+    uint8x8_t mn = vpmin_u8(vget_low_u8(lo), vget_high_u8(lo));
+    uint8x8_t mx = vpmax_u8(vget_low_u8(hi), vget_high_u8(hi));
+    mn = vpmin_u8(mn, mn);
+    mx = vpmax_u8(mx, mx);
+    mn = vpmin_u8(mn, mn);
+    mx = vpmax_u8(mx, mx);
+    stats[0] = packStats((int)vgetq_lane_u64(total, 0), vget_lane_u8(mn, 0), vget_lane_u8(mx, 0));
+    stats[1] = packStats((int)vgetq_lane_u64(total, 1), vget_lane_u8(mn, 1), vget_lane_u8(mx, 1));
+  }
+#elif defined(ZXING_BINARIZER_SSE2)
+  // Stats of two horizontally adjacent blocks, one per 64-bit half.
+  inline void blockPairStats(const unsigned char* pixels, int stride, int* stats) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+    __m128i lo = row;
+    __m128i hi = row;
+    __m128i acc = _mm_sad_epu8(row, zero);
+    for (int yy = 1; yy < BLOCK_SIZE; yy++) {
+      pixels += stride;
+      row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+      lo = _mm_min_epu8(lo, row);
+      hi = _mm_max_epu8(hi, row);
+      acc = _mm_add_epi64(acc, _mm_sad_epu8(row, zero));
+    }
+    // Fold each 64-bit half down to its lowest byte.
+    lo = _mm_min_epu8(lo, _mm_srli_epi64(lo, 32));
+    hi = _mm_max_epu8(hi, _mm_srli_epi64(hi, 32));
+    lo = _mm_min_epu8(lo, _mm_srli_epi64(lo, 16));
+    hi = _mm_max_epu8(hi, _mm_srli_epi64(hi, 16));
+    lo = _mm_min_epu8(lo, _mm_srli_epi64(lo, 8));
+    hi = _mm_max_epu8(hi, _mm_srli_epi64(hi, 8));
+    stats[0] = packStats(_mm_extract_epi16(acc, 0),
+                         _mm_extract_epi16(lo, 0) & 0xFF,
+                         _mm_extract_epi16(hi, 0) & 0xFF);
+    stats[1] = packStats(_mm_extract_epi16(acc, 4),
+                         _mm_extract_epi16(lo, 4) & 0xFF,
+                         _mm_extract_epi16(hi, 4) & 0xFF);
+  }
+#endif
+
+  // Packed stats for every block of the block row starting at blockRow.
+  void blockRowStats(const unsigned char* blockRow, int width, int subWidth, int* stats) {
+    int x = 0;
+#if defined(ZXING_BINARIZER_NEON) || defined(ZXING_BINARIZER_SSE2)
+    for (; ((x + 2) << BLOCK_SIZE_POWER) <= width; x += 2) {
+      blockPairStats(blockRow + (x << BLOCK_SIZE_POWER), width, stats + x);
+    }
+#endif
+    int maxXOffset = width - BLOCK_SIZE;
+    for (; x < subWidth; x++) {
       int xoffset = x << BLOCK_SIZE_POWER;
-      int maxXOffset = width - BLOCK_SIZE;
       if (xoffset > maxXOffset) {
         xoffset = maxXOffset;
       }
-      int left = cap(x, 2, subWidth - 3);
-      int top = cap(y, 2, subHeight - 3);
-      int sum = 0;
-      for (int z = -2; z <= 2; z++) {
-        int *blackRow = &blackPoints[(top + z) * subWidth];
-        sum += blackRow[left - 2];
-        sum += blackRow[left - 1];
-        sum += blackRow[left];
-        sum += blackRow[left + 1];
-        sum += blackRow[left + 2];
-      }
-      int average = sum / 25;
-      thresholdBlock(luminances, xoffset, yoffset, average, width, matrix);
+      stats[x] = blockStats(blockRow + xoffset, width);
     }
   }
-}
 
-void HybridBinarizer::thresholdBlock(ArrayRef<char> luminances,
-                                     int xoffset,
-                                     int yoffset,
-                                     int threshold,
-                                     int stride,
-                                     Ref<BitMatrix> const& matrix) {
-  for (int y = 0, offset = yoffset * stride + xoffset;
-       y < BLOCK_SIZE;
-       y++,  offset += stride) {
-    for (int x = 0; x < BLOCK_SIZE; x++) {
-      int pixel = luminances[offset + x] & 0xff;
-      if (pixel <= threshold) {
-        matrix->set(xoffset + x, yoffset + y);
+  // Packed stats for block rows [begin, end); rows are independent.
+  class BlockStatsJob : public ThreadPool::Job {
+  private:
+    const unsigned char* pixels_;
+    int width_;
+    int height_;
+    int subWidth_;
+    int* stats_;
+  public:
+    BlockStatsJob(const unsigned char* pixels, int width, int height, int subWidth, int* stats) :
+      pixels_(pixels), width_(width), height_(height), subWidth_(subWidth), stats_(stats) {
+    }
+
+    virtual void run(int begin, int end, int) {
+      int maxYOffset = height_ - BLOCK_SIZE;
+      for (int y = begin; y < end; y++) {
+        int yoffset = y << BLOCK_SIZE_POWER;
+        if (yoffset > maxYOffset) {
+          yoffset = maxYOffset;
+        }
+        blockRowStats(pixels_ + yoffset * width_, width_, subWidth_, stats_ + y * subWidth_);
       }
     }
+  };
+}
+
+void HybridBinarizer::calculateBlockStats(ArraySpan<char> luminances,
+                                          int subWidth,
+                                          int subHeight,
+                                          int width,
+                                          int height) {
+  if (!blackPoints_ || blackPoints_->size() != subHeight * subWidth) {
+    blackPoints_ = ArrayRef<int>(subHeight * subWidth);
+  }
+  if (!bandContrast_ || bandContrast_->size() != subHeight) {
+    bandContrast_ = ArrayRef<int>(subHeight);
+  }
+  ArraySpan<int> blackPoints (blackPoints_);
+  const unsigned char* pixels = reinterpret_cast<const unsigned char*>(luminances.data());
+  BlockStatsJob job(pixels, width, height, subWidth, blackPoints.data());
+  if (pool_ && pool_->getThreadCount() > 1) {
+    pool_->parallelFor(subHeight, job);
+  } else {
+    job.run(0, subHeight, 0);
+  }
+
+  // A count rather than a sum of ranges, since blockStats() stops tracking
+  // min and max once the range is met.
+  for (int y = 0; y < subHeight; y++) {
+    int count = 0;
+    for (int x = 0; x < subWidth; x++) {
+      int stats = blackPoints[y * subWidth + x];
+      count += ((stats >> 8) & 0xFF) - (stats & 0xFF) > MIN_DYNAMIC_RANGE;
+    }
+    bandContrast_[y] = count;
   }
+  statsValid_ = true;
 }
 
-namespace {
-  inline int getBlackPointFromNeighbors(ArrayRef<int> blackPoints, int subWidth, int x, int y) {
-    return (blackPoints[(y-1)*subWidth+x] +
-            2*blackPoints[y*subWidth+x-1] +
-            blackPoints[(y-1)*subWidth+x-1]) >> 2;
+/**
+ * The block statistics are computed once per frame, on the first call to
+ * either this or getBandContrast(); the 1D readers can then order their
+ * scanlines by them without binarizing the whole image.
+ */
+ArrayRef<int> HybridBinarizer::getBandContrast() {
+  if (statsValid_) {
+    return bandContrast_;
   }
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int height = source.getHeight();
+  if (width < MINIMUM_DIMENSION || height < MINIMUM_DIMENSION) {
+    return ArrayRef<int>();
+  }
+  int subWidth = (width + BLOCK_SIZE_MASK) >> BLOCK_SIZE_POWER;
+  int subHeight = (height + BLOCK_SIZE_MASK) >> BLOCK_SIZE_POWER;
+  calculateBlockStats(source.getMatrix(), subWidth, subHeight, width, height);
+  return bandContrast_;
 }
 
+int HybridBinarizer::getContrastBandHeight() const {
+  return BLOCK_SIZE;
+}
 
-ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
+ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArraySpan<char> luminances,
                                                     int subWidth,
                                                     int subHeight,
                                                     int width,
                                                     int height) {
-  const int minDynamicRange = 24;
+  if (!statsValid_) {
+    calculateBlockStats(luminances, subWidth, subHeight, width, height);
+  }
+  ArraySpan<int> blackPoints (blackPoints_);
 
-  ArrayRef<int> blackPoints (subHeight * subWidth);
+  // Replace the stats with black points in place. Low-contrast blocks look
+  // at their upper and left neighbours, which have been converted already.
   for (int y = 0; y < subHeight; y++) {
-    int yoffset = y << BLOCK_SIZE_POWER;
-    int maxYOffset = height - BLOCK_SIZE;
-    if (yoffset > maxYOffset) {
-      yoffset = maxYOffset;
-    }
     for (int x = 0; x < subWidth; x++) {
-      int xoffset = x << BLOCK_SIZE_POWER;
-      int maxXOffset = width - BLOCK_SIZE;
-      if (xoffset > maxXOffset) {
-        xoffset = maxXOffset;
-      }
-      int sum = 0;
-      int min = 0xFF;
-      int max = 0;
-      for (int yy = 0, offset = yoffset * width + xoffset;
-           yy < BLOCK_SIZE;
-           yy++, offset += width) {
-        for (int xx = 0; xx < BLOCK_SIZE; xx++) {
-          int pixel = luminances[offset + xx] & 0xFF;
-          sum += pixel;
-          // still looking for good contrast
-          if (pixel < min) {
-            min = pixel;
-          }
-          if (pixel > max) {
-            max = pixel;
-          }
-        }
-
-        // short-circuit min/max tests once dynamic range is met
-        if (max - min > minDynamicRange) {
-          // finish the rest of the rows quickly
-          for (yy++, offset += width; yy < BLOCK_SIZE; yy++, offset += width) {
-            for (int xx = 0; xx < BLOCK_SIZE; xx += 2) {
-              sum += luminances[offset + xx] & 0xFF;
-              sum += luminances[offset + xx + 1] & 0xFF;
-            }
-          }
-        }
-      }
+      int stats = blackPoints[y * subWidth + x];
+      int min = stats & 0xFF;
+      int max = (stats >> 8) & 0xFF;
       // See
       // http://groups.google.com/group/zxing/browse_thread/thread/d06efa2c35a7ddc0
-      int average = sum >> (BLOCK_SIZE_POWER * 2);
-      if (max - min <= minDynamicRange) {
+      int average = (stats >> 16) >> (BLOCK_SIZE_POWER * 2);
+      if (max - min <= MIN_DYNAMIC_RANGE) {
         average = min >> 1;
         if (y > 0 && x > 0) {
           int bp = getBlackPointFromNeighbors(blackPoints, subWidth, x, y);
@@ -221,6 +539,6 @@ ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
       blackPoints[y * subWidth + x] = average;
     }
   }
-  return blackPoints;
+  return blackPoints_;
 }
 
@@ -25,41 +25,58 @@
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/BitArray.h>
 #include <zxing/common/BitMatrix.h>
+#include <zxing/common/ThreadPool.h>
 
 namespace zxing {
 	
 	class HybridBinarizer : public GlobalHistogramBinarizer {
 	 private:
     Ref<BitMatrix> matrix_;
+    bool matrixValid_;
+    ArrayRef<int> blackPoints_;
+    // Blocks per block row with enough dynamic range to threshold locally.
+    ArrayRef<int> bandContrast_;
+    bool statsValid_;
+    // Thresholding scratch, one slice per pool thread.
+    ArrayRef<int> columnSums_;
+    ArrayRef<char> thresholds_;
 	  Ref<BitArray> cached_row_;
+    Ref<ThreadPool> pool_;
 
 	public:
 		HybridBinarizer(Ref<LuminanceSource> source);
+    // Splits the block statistics and thresholding into bands of block rows
+    // across the pool's threads. The result is the same as without a pool.
+    HybridBinarizer(Ref<LuminanceSource> source, Ref<ThreadPool> pool);
 		virtual ~HybridBinarizer();
 		
 		virtual Ref<BitMatrix> getBlackMatrix();
+		virtual void reset();
+    virtual ArrayRef<int> getBandContrast();
+    virtual int getContrastBandHeight() const;
 		Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
   private:
+    // Leaves the packed statistics of every block in blackPoints_ and fills
+    // bandContrast_ from them.
+    void calculateBlockStats(ArraySpan<char> luminances,
+                             int subWidth,
+                             int subHeight,
+                             int width,
+                             int height);
     // We'll be using one-D arrays because C++ can't dynamically allocate 2D
     // arrays
-    ArrayRef<int> calculateBlackPoints(ArrayRef<char> luminances,
+    ArrayRef<int> calculateBlackPoints(ArraySpan<char> luminances,
                                        int subWidth,
                                        int subHeight,
                                        int width,
                                        int height);
-    void calculateThresholdForBlock(ArrayRef<char> luminances,
+    void calculateThresholdForBlock(ArraySpan<char> luminances,
                                     int subWidth,
                                     int subHeight,
                                     int width,
                                     int height,
-                                    ArrayRef<int> blackPoints,
+                                    ArraySpan<int> blackPoints,
                                     Ref<BitMatrix> const& matrix);
-    void thresholdBlock(ArrayRef<char>luminances,
-                        int xoffset,
-                        int yoffset,
-                        int threshold,
-                        int stride,
-                        Ref<BitMatrix> const& matrix);
 	};
 
 }
@@ -0,0 +1,198 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  IntegralImageBinarizer.cpp
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/IntegralImageBinarizer.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+using std::vector;
+using zxing::IntegralImageBinarizer;
+using zxing::Binarizer;
+using zxing::ArrayRef;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::BitMatrix;
+using zxing::DecodeHints;
+using zxing::IllegalArgumentException;
+
+// VC++
+using zxing::LuminanceSource;
+
+namespace {
+  // Sauvola: T = mean * (1 + K * (deviation / R - 1))
+  const float SAUVOLA_K = 0.2f;
+  const float SAUVOLA_R = 128.0f;
+  // Bradley: black when at least this many percent darker than the mean.
+  const int BRADLEY_PERCENT = 15;
+}
+
+IntegralImageBinarizer::IntegralImageBinarizer(Ref<LuminanceSource> source,
+                                               int windowSize,
+                                               Method method)
+  : Binarizer(source), method_(method), matrixValid_(false) {
+  init(windowSize);
+}
+
+IntegralImageBinarizer::IntegralImageBinarizer(Ref<LuminanceSource> source,
+                                               DecodeHints const& hints,
+                                               Method method)
+  : Binarizer(source), method_(method), matrixValid_(false) {
+  int windowSize = hints.getBinarizerWindowSize();
+  init(windowSize > 0 ? windowSize : DEFAULT_WINDOW_SIZE);
+}
+
+IntegralImageBinarizer::~IntegralImageBinarizer() {}
+
+void IntegralImageBinarizer::init(int windowSize) {
+  if (windowSize < 3 || windowSize > MAX_WINDOW_SIZE) {
+    throw IllegalArgumentException("Binarizer window size must be between 3 and 257");
+  }
+  // Centred windows have an odd side.
+  windowSize_ = windowSize | 1;
+}
+
+void IntegralImageBinarizer::reset() {
+  Binarizer::reset();
+  matrixValid_ = false;
+}
+
+int IntegralImageBinarizer::getWindowSize() const {
+  return windowSize_;
+}
+
+IntegralImageBinarizer::Method IntegralImageBinarizer::getMethod() const {
+  return method_;
+}
+
+Ref<Binarizer> IntegralImageBinarizer::createBinarizer(Ref<LuminanceSource> source) {
+  return Ref<Binarizer>(new IntegralImageBinarizer(source, windowSize_, method_));
+}
+
+Ref<BitArray> IntegralImageBinarizer::getBlackRow(int y, Ref<BitArray> row) {
+  return getBlackMatrix()->getRow(y, row);
+}
+
+Ref<BitMatrix> IntegralImageBinarizer::getBlackMatrix() {
+  if (matrixValid_) {
+    return matrix_;
+  }
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int height = source.getHeight();
+  ArrayRef<char> luminances = source.getMatrix();
+  const unsigned char* pixels = reinterpret_cast<const unsigned char*>(&luminances[0]);
+
+  // After a reset() the matrix from the previous frame is recycled; every
+  // word of it is overwritten below.
+  if (!matrix_ || matrix_->getWidth() != width || matrix_->getHeight() != height) {
+    matrix_ = new BitMatrix(width, height);
+  }
+  columnSums_.assign(width, 0);
+  columnSquares_.assign(width, 0);
+  prefixSums_.resize(width + 1);
+  prefixSquares_.resize(width + 1);
+
+  // Slide the window rows [top, bottom] down the image, adding the row that
+  // enters and subtracting the one that leaves.
+  int radius = windowSize_ >> 1;
+  int top = 0;
+  int bottom = -1;
+  for (int y = 0; y < height; y++) {
+    int newBottom = y + radius < height ? y + radius : height - 1;
+    int newTop = y - radius > 0 ? y - radius : 0;
+    while (bottom < newBottom) {
+      bottom++;
+      addRow(pixels + bottom * width, width, false);
+    }
+    while (top < newTop) {
+      addRow(pixels + top * width, width, true);
+      top++;
+    }
+    thresholdRow(pixels + y * width, width, bottom - top + 1, matrix_->getRowBits(y));
+  }
+  matrixValid_ = true;
+  return matrix_;
+}
+
+void IntegralImageBinarizer::addRow(const unsigned char* pixels, int width, bool subtract) {
+  unsigned int* sums = &columnSums_[0];
+  unsigned int* squares = &columnSquares_[0];
+  if (subtract) {
+    for (int x = 0; x < width; x++) {
+      unsigned int pixel = pixels[x];
+      sums[x] -= pixel;
+      squares[x] -= pixel * pixel;
+    }
+  } else {
+    for (int x = 0; x < width; x++) {
+      unsigned int pixel = pixels[x];
+      sums[x] += pixel;
+      squares[x] += pixel * pixel;
+    }
+  }
+}
+
+void IntegralImageBinarizer::thresholdRow(const unsigned char* pixels, int width, int rows, int* words) {
+  // The prefix sums wrap around for wide images. Differences of them are
+  // still exact as long as a window's true sum fits in 32 bits, which
+  // MAX_WINDOW_SIZE guarantees.
+  unsigned int* sums = &prefixSums_[0];
+  unsigned int* squares = &prefixSquares_[0];
+  sums[0] = 0;
+  squares[0] = 0;
+  for (int x = 0; x < width; x++) {
+    sums[x + 1] = sums[x] + columnSums_[x];
+    squares[x + 1] = squares[x] + columnSquares_[x];
+  }
+
+  int radius = windowSize_ >> 1;
+  // The window only shrinks near the borders, so the reciprocal of its
+  // pixel count rarely changes.
+  unsigned int lastCount = 0;
+  float inverseCount = 0;
+  unsigned int word = 0;
+  for (int x = 0; x < width; x++) {
+    int left = x - radius > 0 ? x - radius : 0;
+    int right = x + radius < width ? x + radius + 1 : width;
+    unsigned int count = (unsigned int)((right - left) * rows);
+    unsigned int sum = sums[right] - sums[left];
+    unsigned int pixel = pixels[x];
+    bool black;
+    if (method_ == BRADLEY) {
+      black = (unsigned long long)pixel * count * 100 <=
+        (unsigned long long)sum * (100 - BRADLEY_PERCENT);
+    } else {
+      // pixel <= mean * (1 - K) + K * mean * deviation / R, squared so no
+      // square root is needed.
+      if (count != lastCount) {
+        lastCount = count;
+        inverseCount = 1.0f / count;
+      }
+      float mean = sum * inverseCount;
+      float variance = (squares[right] - squares[left]) * inverseCount - mean * mean;
+      float excess = (pixel - mean * (1.0f - SAUVOLA_K)) * SAUVOLA_R;
+      black = excess <= 0 || excess * excess <= SAUVOLA_K * SAUVOLA_K * mean * mean * variance;
+    }
+    word |= (unsigned int)black << (x & 31);
+    if ((x & 31) == 31 || x == width - 1) {
+      words[x >> 5] = (int)word;
+      word = 0;
+    }
+  }
+}
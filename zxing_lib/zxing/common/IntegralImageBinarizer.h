@@ -0,0 +1,85 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __INTEGRAL_IMAGE_BINARIZER_H__
+#define __INTEGRAL_IMAGE_BINARIZER_H__
+/*
+ *  IntegralImageBinarizer.h
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/Binarizer.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/common/BitArray.h>
+#include <zxing/common/BitMatrix.h>
+
+namespace zxing {
+
+/**
+ * Thresholds every pixel against the window centred on it: its mean for
+ * Bradley, its mean and standard deviation for Sauvola. Window sums come
+ * from a rolling integral image, so the cost per pixel does not depend on
+ * the window size. This copes with lighting gradients that are too steep
+ * for HybridBinarizer's fixed 8x8 blocks and 5x5 block neighbourhood.
+ */
+class IntegralImageBinarizer : public Binarizer {
+public:
+  enum Method {
+    SAUVOLA,
+    BRADLEY
+  };
+
+  static const int DEFAULT_WINDOW_SIZE = 41;
+  // Sums of squares are kept modulo 2^32, which is exact up to this window.
+  static const int MAX_WINDOW_SIZE = 257;
+
+  IntegralImageBinarizer(Ref<LuminanceSource> source,
+                         int windowSize = DEFAULT_WINDOW_SIZE,
+                         Method method = SAUVOLA);
+  // Takes the window size from hints, or DEFAULT_WINDOW_SIZE if unset.
+  IntegralImageBinarizer(Ref<LuminanceSource> source,
+                         DecodeHints const& hints,
+                         Method method = SAUVOLA);
+  virtual ~IntegralImageBinarizer();
+
+  virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+  virtual Ref<BitMatrix> getBlackMatrix();
+  virtual void reset();
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+
+  int getWindowSize() const;
+  Method getMethod() const;
+
+private:
+  int windowSize_;
+  Method method_;
+  Ref<BitMatrix> matrix_;
+  bool matrixValid_;
+  // Per column sums over the window rows, and their prefix sums along the
+  // current row: one row of the integral image at a time.
+  std::vector<unsigned int> columnSums_;
+  std::vector<unsigned int> columnSquares_;
+  std::vector<unsigned int> prefixSums_;
+  std::vector<unsigned int> prefixSquares_;
+
+  void init(int windowSize);
+  void addRow(const unsigned char* pixels, int width, bool subtract);
+  void thresholdRow(const unsigned char* pixels, int width, int rows, int* words);
+};
+
+}
+
+#endif // __INTEGRAL_IMAGE_BINARIZER_H__
@@ -21,10 +21,11 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <vector>
 
 namespace zxing {
-class PerspectiveTransform : public Counted {
+class PerspectiveTransform : public Counted, public ArenaAllocated {
 private:
   float a11, a12, a13, a21, a22, a23, a31, a32, a33;
   PerspectiveTransform(float a11, float a21, float a31, float a12, float a22, float a32, float a13, float a23,
@@ -43,6 +44,8 @@ public:
   void transformPoints(std::vector<float> &points);
 
   friend std::ostream& operator<<(std::ostream& out, const PerspectiveTransform &pt);
+  // Steps the transform along whole rows rather than point by point.
+  friend class GridSampler;
 };
 }
 
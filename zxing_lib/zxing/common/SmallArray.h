@@ -0,0 +1,140 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __SMALL_ARRAY_H__
+#define __SMALL_ARRAY_H__
+
+/*
+ *  SmallArray.h
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace zxing {
+
+/*
+ * An array of up to N elements stored inline, for the many short-lived
+ * arrays of a decode (pattern counters, polynomial coefficients) that
+ * would otherwise each cost a heap allocation. It is a plain value, not
+ * reference counted; it moves to the heap only if it grows past N.
+ * Elements added by resize() or the sized constructor are zeroed, as
+ * with std::vector.
+ */
+template<typename T, int N = 16> class SmallArray {
+private:
+  T inline_[N];
+  T *values_;
+  int size_;
+  int capacity_;
+
+  void reserve(int capacity) {
+    // The inline storage always holds N, so small or empty requests never
+    // reach the heap.
+    if (capacity <= N || capacity <= capacity_) {
+      return;
+    }
+    if (capacity < 2 * capacity_) {
+      capacity = 2 * capacity_;
+    }
+    T *values = new T[capacity];
+    for (int i = 0; i < size_; i++) {
+      values[i] = values_[i];
+    }
+    if (values_ != inline_) {
+      delete[] values_;
+    }
+    values_ = values;
+    capacity_ = capacity;
+  }
+  void assign(T const* ts, int n) {
+    size_ = 0;
+    reserve(n);
+    for (int i = 0; i < n; i++) {
+      values_[i] = ts[i];
+    }
+    size_ = n;
+  }
+
+public:
+  SmallArray() :
+      values_(inline_), size_(0), capacity_(N) {
+  }
+  explicit SmallArray(int n) :
+      values_(inline_), size_(0), capacity_(N) {
+    resize(n);
+  }
+  SmallArray(T const* ts, int n) :
+      values_(inline_), size_(0), capacity_(N) {
+    assign(ts, n);
+  }
+  SmallArray(SmallArray const& other) :
+      values_(inline_), size_(0), capacity_(N) {
+    assign(other.values_, other.size_);
+  }
+  ~SmallArray() {
+    if (values_ != inline_) {
+      delete[] values_;
+    }
+  }
+  SmallArray& operator=(SmallArray const& other) {
+    if (this != &other) {
+      assign(other.values_, other.size_);
+    }
+    return *this;
+  }
+
+  T const& operator[](int i) const {
+    return values_[i];
+  }
+  T& operator[](int i) {
+    return values_[i];
+  }
+  int size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+  T* data() {
+    return values_;
+  }
+  T const* data() const {
+    return values_;
+  }
+
+  void resize(int n) {
+    reserve(n);
+    for (int i = size_; i < n; i++) {
+      values_[i] = T();
+    }
+    size_ = n;
+  }
+  void clear() {
+    size_ = 0;
+  }
+  // Sets every element to value, keeping the size (Arrays.fill).
+  void fill(T const& value) {
+    for (int i = 0; i < size_; i++) {
+      values_[i] = value;
+    }
+  }
+  void push_back(T const& value) {
+    reserve(size_ + 1);
+    values_[size_++] = value;
+  }
+};
+
+}
+
+#endif // __SMALL_ARRAY_H__
@@ -0,0 +1,203 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  ThreadPool.cpp
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/ThreadPool.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <vector>
+
+#if defined(MBED_CONF_RTOS_PRESENT)
+#define ZXING_POOL_RTOS 1
+#include "rtos.h"
+#elif __cplusplus >= 201103L
+#define ZXING_POOL_STD 1
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+using std::vector;
+using zxing::ThreadPool;
+using zxing::IllegalArgumentException;
+
+namespace {
+#if defined(ZXING_POOL_RTOS)
+  typedef rtos::Semaphore Semaphore;
+  typedef rtos::Thread NativeThread;
+  typedef rtos::Mutex Mutex;
+#elif defined(ZXING_POOL_STD)
+  class Semaphore {
+  private:
+    std::mutex mutex_;
+    std::condition_variable posted_;
+    int count_;
+  public:
+    Semaphore() : count_(0) {}
+    void wait() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (count_ == 0) {
+        posted_.wait(lock);
+      }
+      count_--;
+    }
+    void release() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      count_++;
+      posted_.notify_one();
+    }
+  };
+  typedef std::thread NativeThread;
+  typedef std::mutex Mutex;
+#endif
+
+#if defined(ZXING_POOL_RTOS) || defined(ZXING_POOL_STD)
+  class MutexLock {
+  private:
+    Mutex& mutex_;
+    MutexLock(const MutexLock&);
+    MutexLock& operator =(const MutexLock&);
+  public:
+    explicit MutexLock(Mutex& mutex) : mutex_(mutex) {
+      mutex_.lock();
+    }
+    ~MutexLock() {
+      mutex_.unlock();
+    }
+  };
+#endif
+
+  void runShare(ThreadPool::Job& job, int count, int threads, int index) {
+    int begin = (int)((long long)count * index / threads);
+    int end = (int)((long long)count * (index + 1) / threads);
+    if (begin < end) {
+      job.run(begin, end, index);
+    }
+  }
+}
+
+#if defined(ZXING_POOL_RTOS) || defined(ZXING_POOL_STD)
+
+struct ThreadPool::Impl {
+  struct Worker {
+    Impl* pool;
+    int index;
+    Semaphore start;
+    NativeThread* thread;
+
+    void loop() {
+      for (;;) {
+        start.wait();
+        if (pool->stopping) {
+          return;
+        }
+        runShare(*pool->job, pool->count, pool->threads, index);
+        pool->done.release();
+      }
+    }
+
+#if defined(ZXING_POOL_STD)
+    static void enter(Worker* worker) {
+      worker->loop();
+    }
+#endif
+  };
+
+  int threads;
+  vector<Worker*> workers;
+  // Held for a whole parallelFor(); the workers serve one job at a time.
+  Mutex busy;
+  Semaphore done;
+  Job* job;
+  int count;
+  bool stopping;
+
+  explicit Impl(int threads_) : threads(threads_), job(0), count(0), stopping(false) {
+    for (int i = 1; i < threads; i++) {
+      Worker* worker = new Worker();
+      worker->pool = this;
+      worker->index = i;
+#if defined(ZXING_POOL_RTOS)
+      worker->thread = new NativeThread();
+      worker->thread->start(mbed::callback(worker, &Worker::loop));
+#else
+      worker->thread = new NativeThread(&Worker::enter, worker);
+#endif
+      workers.push_back(worker);
+    }
+  }
+
+  ~Impl() {
+    stopping = true;
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i]->start.release();
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i]->thread->join();
+      delete workers[i]->thread;
+      delete workers[i];
+    }
+  }
+
+  void parallelFor(int count_, Job& job_) {
+    MutexLock lock(busy);
+    job = &job_;
+    count = count_;
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i]->start.release();
+    }
+    runShare(job_, count_, threads, 0);
+    for (size_t i = 0; i < workers.size(); i++) {
+      done.wait();
+    }
+  }
+};
+
+#else
+
+// No threads to be had; the whole loop runs on the caller.
+struct ThreadPool::Impl {
+  int threads;
+
+  explicit Impl(int) : threads(1) {}
+
+  void parallelFor(int count, Job& job) {
+    runShare(job, count, 1, 0);
+  }
+};
+
+#endif
+
+ThreadPool::ThreadPool(int threads) : impl_(0) {
+  if (threads < 1) {
+    throw IllegalArgumentException("ThreadPool needs at least one thread");
+  }
+  impl_ = new Impl(threads);
+}
+
+ThreadPool::~ThreadPool() {
+  delete impl_;
+}
+
+int ThreadPool::getThreadCount() const {
+  return impl_->threads;
+}
+
+void ThreadPool::parallelFor(int count, Job& job) {
+  impl_->parallelFor(count, job);
+}
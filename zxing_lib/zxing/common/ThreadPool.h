@@ -0,0 +1,70 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+/*
+ *  ThreadPool.h
+ *  zxing
+ *
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Counted.h>
+
+namespace zxing {
+
+/**
+ * A fixed set of worker threads that split a loop into contiguous ranges.
+ *
+ * Workers are std::thread when built as C++11 and rtos::Thread when the
+ * mbed RTOS is present. Without either, every range runs on the calling
+ * thread. The calling thread always takes the first range itself.
+ */
+class ThreadPool : public Counted {
+public:
+  class Job {
+  public:
+    virtual ~Job() {}
+    // Processes items [begin, end). Ranges never overlap. thread is the
+    // index of the range, below getThreadCount(), for picking per-thread
+    // scratch. Must not throw or allocate, as it may run on a worker thread.
+    virtual void run(int begin, int end, int thread) = 0;
+  };
+
+  // threads includes the caller; ThreadPool(1) starts no workers.
+  explicit ThreadPool(int threads);
+  ~ThreadPool();
+
+  int getThreadCount() const;
+
+  /**
+   * Runs job over [0, count), one contiguous range per thread, and returns
+   * when all ranges are done. Calls from several threads take turns, so
+   * one pool can be shared by decode threads; a Job must not call
+   * parallelFor() itself.
+   */
+  void parallelFor(int count, Job& job);
+
+private:
+  struct Impl;
+  Impl* impl_;
+
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator =(const ThreadPool&);
+};
+
+}
+
+#endif // __THREAD_POOL_H__
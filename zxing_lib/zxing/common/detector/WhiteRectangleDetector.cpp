@@ -313,11 +313,7 @@ vector<Ref<ResultPoint> > WhiteRectangleDetector::centerEdges(Ref<ResultPoint> y
  */
 bool WhiteRectangleDetector::containsBlackPoint(int a, int b, int fixed, bool horizontal) {
   if (horizontal) {
-    for (int x = a; x <= b; x++) {
-      if (image_->get(x, fixed)) {
-        return true;
-      }
-    }
+    return a <= b && image_->countSetBits(a, fixed, b - a + 1, 1) != 0;
   } else {
     for (int y = a; y <= b; y++) {
       if (image_->get(fixed, y)) {
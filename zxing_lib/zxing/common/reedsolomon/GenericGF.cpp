@@ -37,15 +37,14 @@ Ref<GenericGF> GenericGF::DATA_MATRIX_FIELD_256(new GenericGF(0x012D, 256, 1));
 Ref<GenericGF> GenericGF::AZTEC_DATA_8 = DATA_MATRIX_FIELD_256;
 Ref<GenericGF> GenericGF::MAXICODE_FIELD_64 = AZTEC_DATA_6;
   
-namespace {
-  int INITIALIZATION_THRESHOLD = 0;
-}
-  
+// The fields are process-wide statics read by every decoder, so the tables
+// are built up front rather than on first use, and the field and its zero
+// and one polynomials count their references atomically. Concurrent
+// decoders can then share them without locking.
 GenericGF::GenericGF(int primitive_, int size_, int b)
-  : size(size_), primitive(primitive_), generatorBase(b), initialized(false) {
-  if (size <= INITIALIZATION_THRESHOLD) {
-    initialize();
-  }
+  : size(size_), primitive(primitive_), generatorBase(b) {
+  markShared();
+  initialize();
 }
   
 void GenericGF::initialize() {
@@ -67,40 +66,31 @@ void GenericGF::initialize() {
   }
   //logTable[0] == 0 but this should never be used
   zero =
-    Ref<GenericGFPoly>(new GenericGFPoly(*this, ArrayRef<int>(new Array<int>(1))));
+    Ref<GenericGFPoly>(new GenericGFPoly(*this, GenericGFPoly::Coefficients(1)));
   zero->getCoefficients()[0] = 0;
   one =
-    Ref<GenericGFPoly>(new GenericGFPoly(*this, ArrayRef<int>(new Array<int>(1))));
+    Ref<GenericGFPoly>(new GenericGFPoly(*this, GenericGFPoly::Coefficients(1)));
   one->getCoefficients()[0] = 1;
-  initialized = true;
-}
-  
-void GenericGF::checkInit() {
-  if (!initialized) {
-    initialize();
-  }
+  zero->markShared();
+  one->markShared();
 }
   
 Ref<GenericGFPoly> GenericGF::getZero() {
-  checkInit();
   return zero;
 }
   
 Ref<GenericGFPoly> GenericGF::getOne() {
-  checkInit();
   return one;
 }
   
 Ref<GenericGFPoly> GenericGF::buildMonomial(int degree, int coefficient) {
-  checkInit();
-    
   if (degree < 0) {
     throw IllegalArgumentException("Degree must be non-negative");
   }
   if (coefficient == 0) {
     return zero;
   }
-  ArrayRef<int> coefficients(new Array<int>(degree + 1));
+  GenericGFPoly::Coefficients coefficients(degree + 1);
   coefficients[0] = coefficient;
     
   return Ref<GenericGFPoly>(new GenericGFPoly(*this, coefficients));
@@ -111,12 +101,10 @@ int GenericGF::addOrSubtract(int a, int b) {
 }
   
 int GenericGF::exp(int a) {
-  checkInit();
   return expTable[a];
 }
   
 int GenericGF::log(int a) {
-  checkInit();
   if (a == 0) {
     throw IllegalArgumentException("cannot give log(0)");
   }
@@ -124,7 +112,6 @@ int GenericGF::log(int a) {
 }
   
 int GenericGF::inverse(int a) {
-  checkInit();
   if (a == 0) {
     throw IllegalArgumentException("Cannot calculate the inverse of 0");
   }
@@ -132,8 +119,6 @@ int GenericGF::inverse(int a) {
 }
   
 int GenericGF::multiply(int a, int b) {
-  checkInit();
-    
   if (a == 0 || b == 0) {
     return 0;
   }
@@ -38,10 +38,8 @@ namespace zxing {
     int size;
     int primitive;
     int generatorBase;
-    bool initialized;
     
     void initialize();
-    void checkInit();
     
   public:
     static Ref<GenericGF> AZTEC_DATA_12;
@@ -34,10 +34,19 @@ using zxing::GenericGF;
 GenericGFPoly::GenericGFPoly(GenericGF &field,
                              ArrayRef<int> coefficients)
   :  field_(field) {
-  if (coefficients->size() == 0) {
+  setCoefficients(coefficients->empty() ? 0 : &coefficients[0], coefficients->size());
+}
+
+GenericGFPoly::GenericGFPoly(GenericGF &field,
+                             Coefficients const& coefficients)
+  :  field_(field) {
+  setCoefficients(coefficients.data(), coefficients.size());
+}
+
+void GenericGFPoly::setCoefficients(int const* coefficients, int coefficientsLength) {
+  if (coefficientsLength == 0) {
     throw IllegalArgumentException("need coefficients");
   }
-  int coefficientsLength = coefficients->size();
   if (coefficientsLength > 1 && coefficients[0] == 0) {
     // Leading term must be non-zero for anything except the constant polynomial "0"
     int firstNonZero = 1;
@@ -45,24 +54,21 @@ GenericGFPoly::GenericGFPoly(GenericGF &field,
       firstNonZero++;
     }
     if (firstNonZero == coefficientsLength) {
-      coefficients_ = field.getZero()->getCoefficients();
+      coefficients_ = field_.getZero()->getCoefficients();
     } else {
-      coefficients_ = ArrayRef<int>(new Array<int>(coefficientsLength-firstNonZero));
-      for (int i = 0; i < (int)coefficients_->size(); i++) {
-        coefficients_[i] = coefficients[i + firstNonZero];
-      }
+      coefficients_ = Coefficients(coefficients + firstNonZero, coefficientsLength - firstNonZero);
     }
   } else {
-    coefficients_ = coefficients;
+    coefficients_ = Coefficients(coefficients, coefficientsLength);
   }
 }
   
-ArrayRef<int> GenericGFPoly::getCoefficients() {
+GenericGFPoly::Coefficients& GenericGFPoly::getCoefficients() {
   return coefficients_;
 }
   
 int GenericGFPoly::getDegree() {
-  return coefficients_->size() - 1;
+  return coefficients_.size() - 1;
 }
   
 bool GenericGFPoly::isZero() {
@@ -70,7 +76,7 @@ bool GenericGFPoly::isZero() {
 }
   
 int GenericGFPoly::getCoefficient(int degree) {
-  return coefficients_[coefficients_->size() - 1 - degree];
+  return coefficients_[coefficients_.size() - 1 - degree];
 }
   
 int GenericGFPoly::evaluateAt(int a) {
@@ -79,7 +85,7 @@ int GenericGFPoly::evaluateAt(int a) {
     return getCoefficient(0);
   }
     
-  int size = coefficients_->size();
+  int size = coefficients_.size();
   if (a == 1) {
     // Just the sum of the coefficients
     int result = 0;
@@ -95,7 +101,7 @@ int GenericGFPoly::evaluateAt(int a) {
   return result;
 }
   
-Ref<GenericGFPoly> GenericGFPoly::addOrSubtract(Ref<zxing::GenericGFPoly> other) {
+Ref<GenericGFPoly> GenericGFPoly::addOrSubtract(Ref<zxing::GenericGFPoly> const& other) {
   if (!(&field_ == &other->field_)) {
     throw IllegalArgumentException("GenericGFPolys do not have same GenericGF field");
   }
@@ -106,30 +112,30 @@ Ref<GenericGFPoly> GenericGFPoly::addOrSubtract(Ref<zxing::GenericGFPoly> other)
     return Ref<GenericGFPoly>(this);
   }
     
-  ArrayRef<int> smallerCoefficients = coefficients_;
-  ArrayRef<int> largerCoefficients = other->getCoefficients();
+  Coefficients const* smallerCoefficients = &coefficients_;
+  Coefficients const* largerCoefficients = &other->coefficients_;
   if (smallerCoefficients->size() > largerCoefficients->size()) {
-    ArrayRef<int> temp = smallerCoefficients;
+    Coefficients const* temp = smallerCoefficients;
     smallerCoefficients = largerCoefficients;
     largerCoefficients = temp;
   }
     
-  ArrayRef<int> sumDiff(new Array<int>(largerCoefficients->size()));
+  Coefficients sumDiff(largerCoefficients->size());
   int lengthDiff = largerCoefficients->size() - smallerCoefficients->size();
   // Copy high-order terms only found in higher-degree polynomial's coefficients
   for (int i = 0; i < lengthDiff; i++) {
-    sumDiff[i] = largerCoefficients[i];
+    sumDiff[i] = (*largerCoefficients)[i];
   }
     
-  for (int i = lengthDiff; i < (int)largerCoefficients->size(); i++) {
-    sumDiff[i] = GenericGF::addOrSubtract(smallerCoefficients[i-lengthDiff],
-                                          largerCoefficients[i]);
+  for (int i = lengthDiff; i < largerCoefficients->size(); i++) {
+    sumDiff[i] = GenericGF::addOrSubtract((*smallerCoefficients)[i-lengthDiff],
+                                          (*largerCoefficients)[i]);
   }
     
   return Ref<GenericGFPoly>(new GenericGFPoly(field_, sumDiff));
 }
   
-Ref<GenericGFPoly> GenericGFPoly::multiply(Ref<zxing::GenericGFPoly> other) {
+Ref<GenericGFPoly> GenericGFPoly::multiply(Ref<zxing::GenericGFPoly> const& other) {
   if (!(&field_ == &other->field_)) {
     throw IllegalArgumentException("GenericGFPolys do not have same GenericGF field");
   }
@@ -138,13 +144,13 @@ Ref<GenericGFPoly> GenericGFPoly::multiply(Ref<zxing::GenericGFPoly> other) {
     return field_.getZero();
   }
     
-  ArrayRef<int> aCoefficients = coefficients_;
-  int aLength = aCoefficients->size();
+  Coefficients const& aCoefficients = coefficients_;
+  int aLength = aCoefficients.size();
     
-  ArrayRef<int> bCoefficients = other->getCoefficients();
-  int bLength = bCoefficients->size();
+  Coefficients const& bCoefficients = other->coefficients_;
+  int bLength = bCoefficients.size();
     
-  ArrayRef<int> product(new Array<int>(aLength + bLength - 1));
+  Coefficients product(aLength + bLength - 1);
   for (int i = 0; i < aLength; i++) {
     int aCoeff = aCoefficients[i];
     for (int j = 0; j < bLength; j++) {
@@ -163,8 +169,8 @@ Ref<GenericGFPoly> GenericGFPoly::multiply(int scalar) {
   if (scalar == 1) {
     return Ref<GenericGFPoly>(this);
   }
-  int size = coefficients_->size();
-  ArrayRef<int> product(new Array<int>(size));
+  int size = coefficients_.size();
+  Coefficients product(size);
   for (int i = 0; i < size; i++) {
     product[i] = field_.multiply(coefficients_[i], scalar);
   }
@@ -178,15 +184,15 @@ Ref<GenericGFPoly> GenericGFPoly::multiplyByMonomial(int degree, int coefficient
   if (coefficient == 0) {
     return field_.getZero();
   }
-  int size = coefficients_->size();
-  ArrayRef<int> product(new Array<int>(size+degree));
+  int size = coefficients_.size();
+  Coefficients product(size+degree);
   for (int i = 0; i < size; i++) {
     product[i] = field_.multiply(coefficients_[i], coefficient);
   }
   return Ref<GenericGFPoly>(new GenericGFPoly(field_, product));
 }
   
-std::vector<Ref<GenericGFPoly> > GenericGFPoly::divide(Ref<GenericGFPoly> other) {
+std::vector<Ref<GenericGFPoly> > GenericGFPoly::divide(Ref<GenericGFPoly> const& other) {
   if (!(&field_ == &other->field_)) {
     throw IllegalArgumentException("GenericGFPolys do not have same GenericGF field");
   }
@@ -25,28 +25,37 @@
 #include <vector>
 #include <zxing/common/Array.h>
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
+#include <zxing/common/SmallArray.h>
 
 namespace zxing {
 
 class GenericGF;
   
-class GenericGFPoly : public Counted {
+class GenericGFPoly : public Counted, public ArenaAllocated {
+public:
+  // Inline room for the polynomials of typical QR, Data Matrix and Aztec blocks.
+  typedef SmallArray<int, 32> Coefficients;
+
 private:
   GenericGF &field_;
-  ArrayRef<int> coefficients_;
+  Coefficients coefficients_;
+
+  void setCoefficients(int const* coefficients, int coefficientsLength);
     
 public:
   GenericGFPoly(GenericGF &field, ArrayRef<int> coefficients);
-  ArrayRef<int> getCoefficients();
+  GenericGFPoly(GenericGF &field, Coefficients const& coefficients);
+  Coefficients& getCoefficients();
   int getDegree();
   bool isZero();
   int getCoefficient(int degree);
   int evaluateAt(int a);
-  Ref<GenericGFPoly> addOrSubtract(Ref<GenericGFPoly> other);
-  Ref<GenericGFPoly> multiply(Ref<GenericGFPoly> other);
+  Ref<GenericGFPoly> addOrSubtract(Ref<GenericGFPoly> const& other);
+  Ref<GenericGFPoly> multiply(Ref<GenericGFPoly> const& other);
   Ref<GenericGFPoly> multiply(int scalar);
   Ref<GenericGFPoly> multiplyByMonomial(int degree, int coefficient);
-  std::vector<Ref<GenericGFPoly> > divide(Ref<GenericGFPoly> other);
+  std::vector<Ref<GenericGFPoly> > divide(Ref<GenericGFPoly> const& other);
     
 
 };
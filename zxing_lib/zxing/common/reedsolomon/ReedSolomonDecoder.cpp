@@ -41,11 +41,11 @@ ReedSolomonDecoder::~ReedSolomonDecoder() {
 
 void ReedSolomonDecoder::decode(ArrayRef<int> received, int twoS) {
   Ref<GenericGFPoly> poly(new GenericGFPoly(*field, received));
-  ArrayRef<int> syndromeCoefficients(twoS);
+  GenericGFPoly::Coefficients syndromeCoefficients(twoS);
   bool noError = true;
   for (int i = 0; i < twoS; i++) {
     int eval = poly->evaluateAt(field->exp(i + field->getGeneratorBase()));
-    syndromeCoefficients[syndromeCoefficients->size() - 1 - i] = eval;
+    syndromeCoefficients[syndromeCoefficients.size() - 1 - i] = eval;
     if (eval != 0) {
       noError = false;
     }
@@ -128,7 +128,7 @@ vector<Ref<GenericGFPoly> > ReedSolomonDecoder::runEuclideanAlgorithm(Ref<Generi
   return result;
 }
 
-ArrayRef<int> ReedSolomonDecoder::findErrorLocations(Ref<GenericGFPoly> errorLocator) {
+ArrayRef<int> ReedSolomonDecoder::findErrorLocations(Ref<GenericGFPoly> const& errorLocator) {
   // This is a direct application of Chien's search
   int numErrors = errorLocator->getDegree();
   if (numErrors == 1) { // shortcut
@@ -150,7 +150,7 @@ ArrayRef<int> ReedSolomonDecoder::findErrorLocations(Ref<GenericGFPoly> errorLoc
   return result;
 }
 
-ArrayRef<int> ReedSolomonDecoder::findErrorMagnitudes(Ref<GenericGFPoly> errorEvaluator, ArrayRef<int> errorLocations) {
+ArrayRef<int> ReedSolomonDecoder::findErrorMagnitudes(Ref<GenericGFPoly> const& errorEvaluator, ArrayRef<int> const& errorLocations) {
   // This is directly applying Forney's Formula
   int s = errorLocations->size();
   ArrayRef<int> result(new Array<int>(s));
@@ -41,8 +41,8 @@ public:
   std::vector<Ref<GenericGFPoly> > runEuclideanAlgorithm(Ref<GenericGFPoly> a, Ref<GenericGFPoly> b, int R);
 
 private:
-  ArrayRef<int> findErrorLocations(Ref<GenericGFPoly> errorLocator);
-  ArrayRef<int> findErrorMagnitudes(Ref<GenericGFPoly> errorEvaluator, ArrayRef<int> errorLocations);
+  ArrayRef<int> findErrorLocations(Ref<GenericGFPoly> const& errorLocator);
+  ArrayRef<int> findErrorMagnitudes(Ref<GenericGFPoly> const& errorEvaluator, ArrayRef<int> const& errorLocations);
 };
 }
 
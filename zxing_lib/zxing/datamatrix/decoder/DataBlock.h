@@ -23,13 +23,14 @@
 
 #include <vector>
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <zxing/common/Array.h>
 #include <zxing/datamatrix/Version.h>
 
 namespace zxing {
 namespace datamatrix {
 
-class DataBlock : public Counted {
+class DataBlock : public Counted, public ArenaAllocated {
 private:
   int numDataCodewords_;
   ArrayRef<char> codewords_;
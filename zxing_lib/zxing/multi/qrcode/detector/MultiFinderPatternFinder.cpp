@@ -20,6 +20,7 @@
 #include <zxing/multi/qrcode/detector/MultiFinderPatternFinder.h>
 #include <zxing/DecodeHints.h>
 #include <zxing/ReaderException.h>
+#include <zxing/oned/RunLengthRow.h>
 #if defined(__ICCARM__) || defined( __CC_ARM )  //
 #include <math.h>                               //
 #endif                                          //
@@ -30,7 +31,9 @@ using std::sort;
 using std::vector;
 using zxing::Ref;
 using zxing::BitMatrix;
+using zxing::BitArray;
 using zxing::ReaderException;
+using zxing::oned::RunLengthRow;
 using zxing::qrcode::FinderPattern;
 using zxing::qrcode::FinderPatternInfo;
 using zxing::multi::MultiFinderPatternFinder;
@@ -67,7 +70,6 @@ vector<Ref<FinderPatternInfo> > MultiFinderPatternFinder::findMulti(DecodeHints
   bool tryHarder = hints.getTryHarder();
   Ref<BitMatrix> image = image_; // Protected member
   int maxI = image->getHeight();
-  int maxJ = image->getWidth();
   // We are looking for black/white/black/white/black modules in
   // 1:1:3:1:1 ratio; this tracks the number of such modules seen so far
 
@@ -81,52 +83,23 @@ vector<Ref<FinderPatternInfo> > MultiFinderPatternFinder::findMulti(DecodeHints
   }
 
   int stateCount[5];
+  Ref<BitArray> row;
+  RunLengthRow runs;
   for (int i = iSkip - 1; i < maxI; i += iSkip) {
     // Get a row of black/white values
-    stateCount[0] = 0;
-    stateCount[1] = 0;
-    stateCount[2] = 0;
-    stateCount[3] = 0;
-    stateCount[4] = 0;
-    int currentState = 0;
-    for (int j = 0; j < maxJ; j++) {
-      if (image->get(j, i)) {
-        // Black pixel
-        if ((currentState & 1) == 1) { // Counting white pixels
-          currentState++;
-        }
-        stateCount[currentState]++;
-      } else { // White pixel
-        if ((currentState & 1) == 0) { // Counting black pixels
-          if (currentState == 4) { // A winner?
-            if (foundPatternCross(stateCount) && handlePossibleCenter(stateCount, i, j)) { // Yes
-              // Clear state to start looking again
-              currentState = 0;
-              stateCount[0] = 0;
-              stateCount[1] = 0;
-              stateCount[2] = 0;
-              stateCount[3] = 0;
-              stateCount[4] = 0;
-            } else { // No, shift counts back by two
-              stateCount[0] = stateCount[2];
-              stateCount[1] = stateCount[3];
-              stateCount[2] = stateCount[4];
-              stateCount[3] = 1;
-              stateCount[4] = 0;
-              currentState = 3;
-            }
-          } else {
-            stateCount[++currentState]++;
-          }
-        } else { // Counting white pixels
-          stateCount[currentState]++;
-        }
+    row = image->getRow(i, row);
+    runs.reset(row);
+    // Try every five runs that end in a bar, as FinderPatternFinder::find() does
+    int runCount = runs.getRunCount();
+    for (int run = 5; run < runCount; run += 2) {
+      for (int k = 0; k < 5; k++) {
+        stateCount[k] = runs[run - 4 + k];
       }
-    } // for j=...
-
-    if (foundPatternCross(stateCount)) {
-      handlePossibleCenter(stateCount, i, maxJ);
-    } // end if foundPatternCross
+      if (foundPatternCross(stateCount) && handlePossibleCenter(stateCount, i, runs.getRunEnd(run))) {
+        // Start looking again after the space that follows the pattern
+        run += 4;
+      }
+    } // for run=...
   } // for i=iSkip-1 ...
   vector<vector<Ref<FinderPattern> > > patternInfo = selectBestPatterns();
   vector<Ref<FinderPatternInfo> > result;
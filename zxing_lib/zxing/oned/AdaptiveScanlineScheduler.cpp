@@ -0,0 +1,125 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/AdaptiveScanlineScheduler.h>
+#include <algorithm>
+
+using zxing::Ref;
+using zxing::ArrayRef;
+using zxing::BinaryBitmap;
+using zxing::oned::RunLengthRow;
+using zxing::oned::AdaptiveScanlineScheduler;
+
+namespace {
+  const int MAX_LINES = 15;
+  const int REGIONS = 32;
+  // Rows either side of the seed row that are read ahead of the rest.
+  const int SEED_NEIGHBOURS = 2;
+  // The shortest symbol any of the readers accepts, a Code 128 symbol with
+  // nothing but its start, check and stop characters, has ten bars.
+  const int MIN_BARS = 10;
+
+  // Orders rows by the contrast of the band they fall in, busiest first.
+  class ByBandContrast {
+  private:
+    const int* contrast;
+    int bands;
+    int bandHeight;
+    int get(int rowNumber) const {
+      return contrast[std::min(rowNumber / bandHeight, bands - 1)];
+    }
+  public:
+    ByBandContrast(const int* contrast_, int bands_, int bandHeight_)
+      : contrast(contrast_), bands(bands_), bandHeight(bandHeight_) {}
+    bool operator()(int a, int b) const {
+      return get(a) > get(b);
+    }
+  };
+}
+
+AdaptiveScanlineScheduler::AdaptiveScanlineScheduler()
+  : next(0), maxLines(0), width(0), height(0), seedRow(-1), seedWidth(0), seedHeight(0) {}
+
+void AdaptiveScanlineScheduler::queue(int rowNumber) {
+  if (rowNumber >= 0 && rowNumber < height && !queued[rowNumber]) {
+    queued[rowNumber] = true;
+    rows.push_back(rowNumber);
+  }
+}
+
+void AdaptiveScanlineScheduler::start(Ref<BinaryBitmap> const& image, bool tryHarder) {
+  width = image->getWidth();
+  height = image->getHeight();
+  int middle = height >> 1;
+  int rowStep = std::max(1, height >> (tryHarder ? 8 : 5));
+  maxLines = tryHarder ? height : MAX_LINES;
+  next = 0;
+  rows.clear();
+  queued.assign(height, false);
+  quietRegions.assign(REGIONS, false);
+
+  if (seedRow >= 0 && seedWidth == width && seedHeight == height) {
+    queue(seedRow);
+    for (int i = 1; i <= SEED_NEIGHBOURS; i++) {
+      queue(seedRow - i * rowStep);
+      queue(seedRow + i * rowStep);
+    }
+  }
+  int seeded = rows.size();
+
+  // The middle-out grid, carried on to both edges.
+  queue(middle);
+  for (int offset = rowStep; middle - offset >= 0 || middle + offset < height; offset += rowStep) {
+    queue(middle - offset);
+    queue(middle + offset);
+  }
+
+  // A stable sort keeps the middle-out order among equally busy bands.
+  ArrayRef<int> contrast = image->getBandContrast();
+  if (contrast && contrast->size() > 0) {
+    std::stable_sort(rows.begin() + seeded, rows.end(),
+                     ByBandContrast(&contrast[0], contrast->size(), image->getContrastBandHeight()));
+  }
+}
+
+int AdaptiveScanlineScheduler::nextRow() {
+  while (maxLines > 0 && next < (int)rows.size()) {
+    int rowNumber = rows[next++];
+    if (!quietRegions[rowNumber * REGIONS / height]) {
+      maxLines--;
+      return rowNumber;
+    }
+  }
+  return -1;
+}
+
+void AdaptiveScanlineScheduler::rowScanned(int rowNumber, RunLengthRow const& row) {
+  // Every other run is a bar.
+  if (row.getRunCount() / 2 < MIN_BARS) {
+    quietRegions[rowNumber * REGIONS / height] = true;
+  }
+}
+
+void AdaptiveScanlineScheduler::rowDecoded(int rowNumber) {
+  seedRow = rowNumber;
+  seedWidth = width;
+  seedHeight = height;
+}
+
+void AdaptiveScanlineScheduler::clearSeed() {
+  seedRow = -1;
+}
@@ -0,0 +1,69 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ADAPTIVE_SCANLINE_SCHEDULER_H__
+#define __ADAPTIVE_SCANLINE_SCHEDULER_H__
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/ScanlineScheduler.h>
+#include <vector>
+
+namespace zxing {
+namespace oned {
+
+/**
+ * Spends the row budget where a barcode is likely to be, for streams in
+ * which codes keep turning up in the same part of the frame.
+ *
+ * Rows are taken from the same grid as the middle-out order, but over the
+ * whole height, and visited busiest first by the binarizer's band contrast
+ * (binarizers without it leave the middle-out order alone). The row a code
+ * was last found on, and its neighbours, go before all others as long as
+ * the images keep the same size. A region of 1/32 of the height is given
+ * up as soon as one of its rows turns out to hold too few bars for any
+ * barcode. Unless trying harder, at most 15 rows are read, as before.
+ */
+class AdaptiveScanlineScheduler : public ScanlineScheduler {
+private:
+  std::vector<int> rows;
+  std::vector<bool> queued;
+  std::vector<bool> quietRegions;
+  int next;
+  int maxLines;
+  int width;
+  int height;
+
+  int seedRow;
+  int seedWidth;
+  int seedHeight;
+
+  void queue(int rowNumber);
+
+public:
+  AdaptiveScanlineScheduler();
+
+  void start(Ref<BinaryBitmap> const& image, bool tryHarder);
+  int nextRow();
+  void rowScanned(int rowNumber, RunLengthRow const& row);
+  void rowDecoded(int rowNumber);
+
+  /** Forgets the row a code was last found on. */
+  void clearSeed();
+};
+
+}
+}
+
+#endif
@@ -36,7 +36,7 @@ using zxing::Result;
 using zxing::oned::CodaBarReader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 namespace {
   char const ALPHABET_STRING[] = "0123456789-$:/.+ABCD";
@@ -76,22 +76,27 @@ const int CodaBarReader::PADDING =
 CodaBarReader::CodaBarReader() 
   : counters(80, 0), counterLength(0) {}
 
-Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> CodaBarReader::decodeRuns(int rowNumber, RunLengthRow const& row) {
 
   { // Arrays.fill(counters, 0);
     int size = counters.size();
     counters.resize(0);
     counters.resize(size); }
 
-  setCounters(row);
+  if (!setCounters(row)) {
+    return Ref<Result>();
+  }
   int startOffset = findStartPattern();
+  if (startOffset < 0) {
+    return Ref<Result>();
+  }
   int nextStart = startOffset;
 
   decodeRowResult.clear();
   do {
     int charOffset = toNarrowWidePattern(nextStart);
     if (charOffset == -1) {
-      throw NotFoundException();
+      return Ref<Result>();
     }
     // Hack: We store the position in the alphabet table into a
     // StringBuilder, so that we can access the decoded patterns in
@@ -116,10 +121,12 @@ Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> row) {
   // otherwise this is probably a false positive. The exception is if we are
   // at the end of the row. (I.e. the barcode barely fits.)
   if (nextStart < counterLength && trailingWhitespace < lastPatternSize / 2) {
-    throw NotFoundException();
+    return Ref<Result>();
   }
 
-  validatePattern(startOffset);
+  if (!validatePattern(startOffset)) {
+    return Ref<Result>();
+  }
 
   // Translate character table offsets to actual characters.
   for (int i = 0; i < (int)decodeRowResult.length(); i++) {
@@ -128,17 +135,17 @@ Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> row) {
   // Ensure a valid start and end character
   char startchar = decodeRowResult[0];
   if (!arrayContains(STARTEND_ENCODING, startchar)) {
-    throw NotFoundException();
+    return Ref<Result>();
   }
   char endchar = decodeRowResult[decodeRowResult.length() - 1];
   if (!arrayContains(STARTEND_ENCODING, endchar)) {
-    throw NotFoundException();
+    return Ref<Result>();
   }
 
   // remove stop/start characters character and check if a long enough string is contained
   if ((int)decodeRowResult.length() <= MIN_CHARACTER_LENGTH) {
     // Almost surely a false positive ( start + stop + at least 1 character)
-    throw NotFoundException();
+    return Ref<Result>();
   }
 
   decodeRowResult.erase(decodeRowResult.length() - 1, 1);
@@ -166,10 +173,10 @@ Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> row) {
                                 BarcodeFormat::CODABAR));
 }
 
-void CodaBarReader::validatePattern(int start)  {
+bool CodaBarReader::validatePattern(int start)  {
   // First, sum up the total size of our four categories of stripe sizes;
-  vector<int> sizes (4, 0);
-  vector<int> counts (4, 0);
+  Counters sizes (4);
+  Counters counts (4);
   int end = decodeRowResult.length() - 1;
 
   // We break out of this loop in the middle, in order to handle
@@ -193,8 +200,8 @@ void CodaBarReader::validatePattern(int start)  {
   }
 
   // Calculate our allowable size thresholds using fixed-point math.
-  vector<int> maxes (4, 0);
-  vector<int> mins (4, 0);
+  Counters maxes (4);
+  Counters mins (4);
   // Define the threshold of acceptability to be the midpoint between the
   // average small stripe and the average large stripe. No stripe lengths
   // should be on the "wrong" side of that line.
@@ -216,7 +223,7 @@ void CodaBarReader::validatePattern(int start)  {
       int category = (j & 1) + (pattern & 1) * 2;
       int size = counters[pos + j] << INTEGER_MATH_SHIFT;
       if (size < mins[category] || size > maxes[category]) {
-        throw NotFoundException();
+        return false;
       }
       pattern >>= 1;
     }
@@ -225,6 +232,7 @@ void CodaBarReader::validatePattern(int start)  {
     }
     pos += 8;
   }
+  return true;
 }
 
 /**
@@ -232,27 +240,20 @@ void CodaBarReader::validatePattern(int start)  {
  * This is just like recordPattern, except it records all the counters, and
  * uses our builtin "counters" member for storage.
  * @param row row to count from
+ * @return false if the row is all black
  */
-void CodaBarReader::setCounters(Ref<BitArray> row)  {
+bool CodaBarReader::setCounters(RunLengthRow const& row)  {
   counterLength = 0;
-  // Start from the first white bit.
-  int i = row->getNextUnset(0);
-  int end = row->getSize();
+  // Start from the first white run; run 0 is empty if the row starts black.
+  int i = row[0] > 0 ? 0 : 2;
+  int end = row.getRunCount();
   if (i >= end) {
-    throw NotFoundException();
+    return false;
   }
-  bool isWhite = true;
-  int count = 0;
   for (; i < end; i++) {
-    if (row->get(i) ^ isWhite) { // that is, exactly one is true
-      count++;
-    } else {
-      counterAppend(count);
-      count = 1;
-      isWhite = !isWhite;
-    }
+    counterAppend(row[i]);
   }
-  counterAppend(count);
+  return true;
 }
 
 void CodaBarReader::counterAppend(int e) {
@@ -279,7 +280,7 @@ int CodaBarReader::findStartPattern() {
       }
     }
   }
-  throw NotFoundException();
+  return -1;
 }
 
 bool CodaBarReader::arrayContains(char const array[], char key) {
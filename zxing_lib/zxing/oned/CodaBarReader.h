@@ -37,12 +37,12 @@ private:
 public:
   CodaBarReader();
 
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
   
-  void validatePattern(int start);
+  bool validatePattern(int start);
 
 private:
-  void setCounters(Ref<BitArray> row);
+  bool setCounters(RunLengthRow const& row);
   void counterAppend(int e);
   int findStartPattern();
   
@@ -38,7 +38,7 @@ using zxing::Result;
 using zxing::oned::Code128Reader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 const int Code128Reader::MAX_AVG_VARIANCE = int(PATTERN_MATCH_RESULT_SCALE_FACTOR * 250/1000);
 const int Code128Reader::MAX_INDIVIDUAL_VARIANCE = int(PATTERN_MATCH_RESULT_SCALE_FACTOR * 700/1000);
@@ -177,58 +177,44 @@ const int CODE_PATTERNS[CODE_PATTERNS_LENGTH][6] = {
 
 Code128Reader::Code128Reader(){}
 
-vector<int> Code128Reader::findStartPattern(Ref<BitArray> row){
-  int width = row->getSize();
-  int rowOffset = row->getNextSet(0);
-
-  int counterPosition = 0;
-  vector<int> counters (6, 0);
-  int patternStart = rowOffset;
-  bool isWhite = false;
+vector<int> Code128Reader::findStartPattern(RunLengthRow const& row){
+  Counters counters (6);
   int patternLength =  counters.size();
 
-  for (int i = rowOffset; i < width; i++) {
-    if (row->get(i) ^ isWhite) {
-      counters[counterPosition]++;
-    } else {
-      if (counterPosition == patternLength - 1) {
-        int bestVariance = MAX_AVG_VARIANCE;
-        int bestMatch = -1;
-        for (int startCode = CODE_START_A; startCode <= CODE_START_C; startCode++) {
-          int variance = patternMatchVariance(counters, CODE_PATTERNS[startCode], MAX_INDIVIDUAL_VARIANCE);
-          if (variance < bestVariance) {
-            bestVariance = variance;
-            bestMatch = startCode;
-          }
-        }
-        // Look for whitespace before start pattern, >= 50% of width of start pattern
-        if (bestMatch >= 0 &&
-            row->isRange(std::max(0, patternStart - (i - patternStart) / 2), patternStart, false)) {
-          vector<int> resultValue (3, 0);
-          resultValue[0] = patternStart;
-          resultValue[1] = i;
-          resultValue[2] = bestMatch;
-          return resultValue;
-        }
-        patternStart += counters[0] + counters[1];
-        for (int y = 2; y < patternLength; y++) {
-          counters[y - 2] = counters[y];
-        }
-        counters[patternLength - 2] = 0;
-        counters[patternLength - 1] = 0;
-        counterPosition--;
-      } else {
-        counterPosition++;
+  // Try each window of runs that starts with a bar and is followed by more
+  // of the row.
+  for (int run = 1; run + patternLength < row.getRunCount(); run += 2) {
+    int patternStart = row.getRunStart(run);
+    int i = row.getRunStart(run + patternLength);
+    for (int y = 0; y < patternLength; y++) {
+      counters[y] = row[run + y];
+    }
+    int bestVariance = MAX_AVG_VARIANCE;
+    int bestMatch = -1;
+    for (int startCode = CODE_START_A; startCode <= CODE_START_C; startCode++) {
+      int variance = patternMatchVariance(counters, CODE_PATTERNS[startCode], MAX_INDIVIDUAL_VARIANCE);
+      if (variance < bestVariance) {
+        bestVariance = variance;
+        bestMatch = startCode;
       }
-      counters[counterPosition] = 1;
-      isWhite = !isWhite;
+    }
+    // Look for whitespace before start pattern, >= 50% of width of start pattern
+    if (bestMatch >= 0 &&
+        row.isRange(std::max(0, patternStart - (i - patternStart) / 2), patternStart, false)) {
+      vector<int> resultValue (3, 0);
+      resultValue[0] = patternStart;
+      resultValue[1] = i;
+      resultValue[2] = bestMatch;
+      return resultValue;
     }
   }
-  throw NotFoundException();
+  return vector<int>();
 }
 
-int Code128Reader::decodeCode(Ref<BitArray> row, vector<int>& counters, int rowOffset) {
-  recordPattern(row, rowOffset, counters);
+int Code128Reader::decodeCode(RunLengthRow const& row, Counters& counters, int rowOffset) {
+  if (!tryRecordPattern(row, rowOffset, counters)) {
+    return -1;
+  }
   int bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
   int bestMatch = -1;
   for (int d = 0; d < CODE_PATTERNS_LENGTH; d++) {
@@ -240,17 +226,16 @@ int Code128Reader::decodeCode(Ref<BitArray> row, vector<int>& counters, int rowO
     }
   }
   // TODO We're overlooking the fact that the STOP pattern has 7 values, not 6.
-  if (bestMatch >= 0) {
-    return bestMatch;
-  } else {
-    throw NotFoundException();
-  }
+  return bestMatch;
 }
 
-Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> Code128Reader::decodeRuns(int rowNumber, RunLengthRow const& row) {
   // boolean convertFNC1 = hints != null && hints.containsKey(DecodeHintType.ASSUME_GS1);
   boolean convertFNC1 = false;
   vector<int> startPatternInfo (findStartPattern(row));
+  if (startPatternInfo.empty()) {
+    return Ref<Result>();
+  }
   int startCode = startPatternInfo[2];
   int codeSet;
   switch (startCode) {
@@ -264,7 +249,7 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
       codeSet = CODE_CODE_C;
       break;
     default:
-      throw FormatException();
+      return Ref<Result>();
   }
 
   bool done = false;
@@ -275,7 +260,7 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
 
   int lastStart = startPatternInfo[0];
   int nextStart = startPatternInfo[1];
-  vector<int> counters (6, 0);
+  Counters counters (6);
 
   int lastCode = 0;
   int code = 0;
@@ -294,6 +279,9 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
     lastCode = code;
 
     code = decodeCode(row, counters, nextStart);
+    if (code < 0) {
+      return Ref<Result>();
+    }
 
     // Remember whether the last code was printable or not (excluding CODE_STOP)
     if (code != CODE_STOP) {
@@ -317,7 +305,7 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
       case CODE_START_A:
       case CODE_START_B:
       case CODE_START_C:
-        throw FormatException();
+        return Ref<Result>();
     }
 
     switch (codeSet) {
@@ -440,25 +428,25 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
   // Check for ample whitespace following pattern, but, to do this we first need to remember that
   // we fudged decoding CODE_STOP since it actually has 7 bars, not 6. There is a black bar left
   // to read off. Would be slightly better to properly read. Here we just skip it:
-  nextStart = row->getNextUnset(nextStart);
-  if (!row->isRange(nextStart,
-                    std::min(row->getSize(), nextStart + (nextStart - lastStart) / 2),
-                    false)) {
-    throw NotFoundException();
+  nextStart = row.getNextUnset(nextStart);
+  if (!row.isRange(nextStart,
+                   std::min(row.getSize(), nextStart + (nextStart - lastStart) / 2),
+                   false)) {
+    return Ref<Result>();
   }
 
   // Pull out from sum the value of the penultimate check code
   checksumTotal -= multiplier * lastCode;
   // lastCode is the checksum then:
   if (checksumTotal % 103 != lastCode) {
-    throw ChecksumException();
+    return Ref<Result>();
   }
 
   // Need to pull out the check digits from string
   int resultLength = result.length();
   if (resultLength == 0) {
     // false positive
-    throw NotFoundException();
+    return Ref<Result>();
   }
 
   // Only bother if the result had at least one character, and if the checksum digit happened to
@@ -29,13 +29,14 @@ private:
   static const int MAX_AVG_VARIANCE;
   static const int MAX_INDIVIDUAL_VARIANCE;
 
-  static std::vector<int> findStartPattern(Ref<BitArray> row);
-  static int decodeCode(Ref<BitArray> row,
-                        std::vector<int>& counters,
+  // These report a miss as an empty vector and -1 rather than by throwing.
+  static std::vector<int> findStartPattern(RunLengthRow const& row);
+  static int decodeCode(RunLengthRow const& row,
+                        Counters& counters,
                         int rowOffset);
 			
 public:
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
   Code128Reader();
   ~Code128Reader();
 
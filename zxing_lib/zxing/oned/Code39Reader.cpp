@@ -34,7 +34,7 @@ using zxing::ChecksumException;
 using zxing::oned::Code39Reader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 namespace {
   const char* ALPHABET = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-. *$/+%";
@@ -92,36 +92,41 @@ Code39Reader::Code39Reader(bool usingCheckDigit_, bool extendedMode_) {
   init(usingCheckDigit_, extendedMode_);
 }
 
-Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
-  std::vector<int>& theCounters (counters);
-  { // Arrays.fill(counters, 0);
-    int size = theCounters.size();
-    theCounters.resize(0);
-    theCounters.resize(size); }
+Ref<Result> Code39Reader::decodeRuns(int rowNumber, RunLengthRow const& row) {
+  Counters& theCounters (counters);
+  theCounters.fill(0);
   std::string& result (decodeRowResult);
   result.clear();
 
   vector<int> start (findAsteriskPattern(row, theCounters));
+  if (start.empty()) {
+    return Ref<Result>();
+  }
   // Read off white space
-  int nextStart = row->getNextSet(start[1]);
-  int end = row->getSize();
+  int nextStart = row.getNextSet(start[1]);
+  int end = row.getSize();
 
   char decodedChar;
   int lastStart;
   do {
-    recordPattern(row, nextStart, theCounters);
+    if (!tryRecordPattern(row, nextStart, theCounters)) {
+      return Ref<Result>();
+    }
     int pattern = toNarrowWidePattern(theCounters);
     if (pattern < 0) {
-      throw NotFoundException();;
+      return Ref<Result>();
     }
     decodedChar = patternToChar(pattern);
+    if (decodedChar == 0) {
+      return Ref<Result>();
+    }
     result.append(1, decodedChar);
     lastStart = nextStart;
     for (int i = 0, end=theCounters.size(); i < end; i++) {
       nextStart += theCounters[i];
     }
     // Read off white space
-    nextStart = row->getNextSet(nextStart);
+    nextStart = row.getNextSet(nextStart);
   } while (decodedChar != '*');
   result.resize(decodeRowResult.length()-1);// remove asterisk
 
@@ -134,7 +139,7 @@ Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
   // If 50% of last pattern size, following last pattern, is not whitespace,
   // fail (but if it's whitespace to the very end of the image, that's OK)
   if (nextStart != end && (whiteSpaceAfterEnd << 1) < lastPatternSize) {
-    throw NotFoundException();
+    return Ref<Result>();
   }
 
   if (usingCheckDigit) {
@@ -144,14 +149,14 @@ Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
       total += alphabet_string.find_first_of(decodeRowResult[i], 0);
     }
     if (result[max] != ALPHABET[total % 43]) {
-      throw ChecksumException();
+      return Ref<Result>();
     }
     result.resize(max);
   }
   
   if (result.length() == 0) {
     // Almost false positive
-    throw NotFoundException();
+    return Ref<Result>();
   }
   
   Ref<String> resultString;
@@ -175,49 +180,34 @@ Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
     );
 }
 
-vector<int> Code39Reader::findAsteriskPattern(Ref<BitArray> row, vector<int>& counters){
-  int width = row->getSize();
-  int rowOffset = row->getNextSet(0);
-
-  int counterPosition = 0;
-  int patternStart = rowOffset;
-  bool isWhite = false;
+vector<int> Code39Reader::findAsteriskPattern(RunLengthRow const& row, Counters& counters){
   int patternLength = counters.size();
 
-  for (int i = rowOffset; i < width; i++) {
-    if (row->get(i) ^ isWhite) {
-      counters[counterPosition]++;
-    } else {
-      if (counterPosition == patternLength - 1) {
-        // Look for whitespace before start pattern, >= 50% of width of
-        // start pattern.
-        if (toNarrowWidePattern(counters) == ASTERISK_ENCODING &&
-            row->isRange(std::max(0, patternStart - ((i - patternStart) >> 1)), patternStart, false)) {
-          vector<int> resultValue (2, 0);
-          resultValue[0] = patternStart;
-          resultValue[1] = i;
-          return resultValue;
-        }
-        patternStart += counters[0] + counters[1];
-        for (int y = 2; y < patternLength; y++) {
-          counters[y - 2] = counters[y];
-        }
-        counters[patternLength - 2] = 0;
-        counters[patternLength - 1] = 0;
-        counterPosition--;
-      } else {
-        counterPosition++;
-      }
-      counters[counterPosition] = 1;
-      isWhite = !isWhite;
+  // Slide a window of patternLength runs, starting on a bar, along the row.
+  // The last window must be followed by another run, as a pattern is only
+  // known to have ended once the colour changes.
+  for (int run = 1; run + patternLength < row.getRunCount(); run += 2) {
+    int patternStart = row.getRunStart(run);
+    int i = row.getRunStart(run + patternLength);
+    for (int y = 0; y < patternLength; y++) {
+      counters[y] = row[run + y];
+    }
+    // Look for whitespace before start pattern, >= 50% of width of
+    // start pattern.
+    if (toNarrowWidePattern(counters) == ASTERISK_ENCODING &&
+        row.isRange(std::max(0, patternStart - ((i - patternStart) >> 1)), patternStart, false)) {
+      vector<int> resultValue (2, 0);
+      resultValue[0] = patternStart;
+      resultValue[1] = i;
+      return resultValue;
     }
   }
-  throw NotFoundException();
+  return vector<int>();
 }
 
 // For efficiency, returns -1 on failure. Not throwing here saved as many as
 // 700 exceptions per image when using some of our blackbox images.
-int Code39Reader::toNarrowWidePattern(vector<int>& counters){
+int Code39Reader::toNarrowWidePattern(Counters& counters){
   int numCounters = counters.size();
   int maxNarrowCounter = 0;
   int wideCounters;
@@ -268,7 +258,7 @@ char Code39Reader::patternToChar(int pattern){
       return ALPHABET[i];
     }
   }
-  throw ReaderException("");
+  return 0;
 }
 
 Ref<String> Code39Reader::decodeExtended(std::string encoded){
@@ -37,13 +37,14 @@ private:
   bool usingCheckDigit;
   bool extendedMode;
   std::string decodeRowResult;
-  std::vector<int> counters;
+  Counters counters;
 			
   void init(bool usingCheckDigit = false, bool extendedMode = false);
 
-  static std::vector<int> findAsteriskPattern(Ref<BitArray> row,
-                                              std::vector<int>& counters);
-  static int toNarrowWidePattern(std::vector<int>& counters);
+  // These report a miss as an empty vector, -1 and 0 rather than by throwing.
+  static std::vector<int> findAsteriskPattern(RunLengthRow const& row,
+                                              Counters& counters);
+  static int toNarrowWidePattern(Counters& counters);
   static char patternToChar(int pattern);
   static Ref<String> decodeExtended(std::string encoded);
 			
@@ -54,7 +55,7 @@ public:
   Code39Reader(bool usingCheckDigit_);
   Code39Reader(bool usingCheckDigit_, bool extendedMode_);
 			
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
 };
 
 }
@@ -35,7 +35,7 @@ using zxing::ChecksumException;
 using zxing::oned::Code93Reader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 namespace {
   char const ALPHABET[] =
@@ -64,36 +64,41 @@ Code93Reader::Code93Reader() {
   counters.resize(6);
 }
 
-Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> Code93Reader::decodeRuns(int rowNumber, RunLengthRow const& row) {
   Range start (findAsteriskPattern(row));
+  if (!start.isValid()) {
+    return Ref<Result>();
+  }
   // Read off white space    
-  int nextStart = row->getNextSet(start[1]);
-  int end = row->getSize();
+  int nextStart = row.getNextSet(start[1]);
+  int end = row.getSize();
 
-  vector<int>& theCounters (counters);
-  { // Arrays.fill(counters, 0);
-    int size = theCounters.size();
-    theCounters.resize(0);
-    theCounters.resize(size); }
+  Counters& theCounters (counters);
+  theCounters.fill(0);
   string& result (decodeRowResult);
   result.clear();
 
   char decodedChar;
   int lastStart;
   do {
-    recordPattern(row, nextStart, theCounters);
+    if (!tryRecordPattern(row, nextStart, theCounters)) {
+      return Ref<Result>();
+    }
     int pattern = toPattern(theCounters);
     if (pattern < 0) {
-      throw NotFoundException();
+      return Ref<Result>();
     }
     decodedChar = patternToChar(pattern);
+    if (decodedChar == 0) {
+      return Ref<Result>();
+    }
     result.append(1, decodedChar);
     lastStart = nextStart;
     for(int i=0, e=theCounters.size(); i < e; ++i) {
       nextStart += theCounters[i];
     }
     // Read off white space
-    nextStart = row->getNextSet(nextStart);
+    nextStart = row.getNextSet(nextStart);
   } while (decodedChar != '*');
   result.resize(result.length() - 1); // remove asterisk
 
@@ -104,16 +109,18 @@ Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
   }
   
   // Should be at least one more black module
-  if (nextStart == end || !row->get(nextStart)) {
-    throw NotFoundException();
+  if (nextStart == end || !row.get(nextStart)) {
+    return Ref<Result>();
   }
 
   if (result.length() < 2) {
     // false positive -- need at least 2 checksum digits
-    throw NotFoundException();
+    return Ref<Result>();
   }
 
-  checkChecksums(result);
+  if (!checkChecksums(result)) {
+    return Ref<Result>();
+  }
   // Remove checksum digits
   result.resize(result.length() - 2);
 
@@ -135,47 +142,24 @@ Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
                        BarcodeFormat::CODE_93));
 }
 
-Code93Reader::Range Code93Reader::findAsteriskPattern(Ref<BitArray> row)  {
-  int width = row->getSize();
-  int rowOffset = row->getNextSet(0);
-
-  { // Arrays.fill(counters, 0);
-    int size = counters.size();
-    counters.resize(0);
-    counters.resize(size); }
-  vector<int>& theCounters (counters);
-
-  int patternStart = rowOffset;
-  bool isWhite = false;
+Code93Reader::Range Code93Reader::findAsteriskPattern(RunLengthRow const& row)  {
+  Counters& theCounters (counters);
   int patternLength = theCounters.size();
 
-  int counterPosition = 0;
-  for (int i = rowOffset; i < width; i++) {
-    if (row->get(i) ^ isWhite) {
-      theCounters[counterPosition]++;
-    } else {
-      if (counterPosition == patternLength - 1) {
-        if (toPattern(theCounters) == ASTERISK_ENCODING) {
-          return Range(patternStart, i);
-        }
-        patternStart += theCounters[0] + theCounters[1];
-        for (int y = 2; y < patternLength; y++) {
-          theCounters[y - 2] = theCounters[y];
-        }
-        theCounters[patternLength - 2] = 0;
-        theCounters[patternLength - 1] = 0;
-        counterPosition--;
-      } else {
-        counterPosition++;
-      }
-      theCounters[counterPosition] = 1;
-      isWhite = !isWhite;
+  // Slide a window of patternLength runs, starting on a bar, along the row;
+  // it must be followed by another run to be known to have ended.
+  for (int run = 1; run + patternLength < row.getRunCount(); run += 2) {
+    for (int y = 0; y < patternLength; y++) {
+      theCounters[y] = row[run + y];
+    }
+    if (toPattern(theCounters) == ASTERISK_ENCODING) {
+      return Range(row.getRunStart(run), row.getRunStart(run + patternLength));
     }
   }
-  throw NotFoundException();
+  return Range();
 }
 
-int Code93Reader::toPattern(vector<int>& counters) {
+int Code93Reader::toPattern(Counters& counters) {
   int max = counters.size();
   int sum = 0;
   for(int i=0, e=counters.size(); i<e; ++i) {
@@ -208,7 +192,7 @@ char Code93Reader::patternToChar(int pattern)  {
       return ALPHABET[i];
     }
   }
-  throw NotFoundException();
+  return 0;
 }
 
 Ref<String> Code93Reader::decodeExtended(string const& encoded)  {
@@ -280,13 +264,13 @@ Ref<String> Code93Reader::decodeExtended(string const& encoded)  {
   return Ref<String>(new String(decoded));
 }
 
-void Code93Reader::checkChecksums(string const& result) {
+bool Code93Reader::checkChecksums(string const& result) {
   int length = result.length();
-  checkOneChecksum(result, length - 2, 20);
-  checkOneChecksum(result, length - 1, 15);
+  return checkOneChecksum(result, length - 2, 20) &&
+         checkOneChecksum(result, length - 1, 15);
 }
 
-void Code93Reader::checkOneChecksum(string const& result,
+bool Code93Reader::checkOneChecksum(string const& result,
                                     int checkPosition,
                                     int weightMax) {
   int weight = 1;
@@ -297,7 +281,5 @@ void Code93Reader::checkOneChecksum(string const& result,
       weight = 1;
     }
   }
-  if (result[checkPosition] != ALPHABET[total % 47]) {
-    throw ChecksumException();
-  }
+  return result[checkPosition] == ALPHABET[total % 47];
 }
@@ -35,19 +35,21 @@ namespace oned {
 class Code93Reader : public OneDReader {
 public:
   Code93Reader();
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
 
 private:
   std::string decodeRowResult;
-  std::vector<int> counters;
+  Counters counters;
 
-  Range findAsteriskPattern(Ref<BitArray> row);
+  // These report a miss as an invalid Range, -1, 0 and false rather than by
+  // throwing.
+  Range findAsteriskPattern(RunLengthRow const& row);
 
-  static int toPattern(std::vector<int>& counters);
+  static int toPattern(Counters& counters);
   static char patternToChar(int pattern);
   static Ref<String> decodeExtended(std::string const& encoded);
-  static void checkChecksums(std::string const& result);
-  static void checkOneChecksum(std::string const& result,
+  static bool checkChecksums(std::string const& result);
+  static bool checkOneChecksum(std::string const& result,
                                int checkPosition,
                                int weightMax);
 };
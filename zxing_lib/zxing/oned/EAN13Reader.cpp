@@ -20,7 +20,7 @@
 
 using std::vector;
 using zxing::Ref;
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 using zxing::oned::EAN13Reader;
 
 namespace {
@@ -29,21 +29,24 @@ namespace {
   };
 }
 
-EAN13Reader::EAN13Reader() : decodeMiddleCounters(4, 0) { }
+EAN13Reader::EAN13Reader() : decodeMiddleCounters(4) { }
 
-int EAN13Reader::decodeMiddle(Ref<BitArray> row,
+int EAN13Reader::decodeMiddle(RunLengthRow const& row,
                               Range const& startRange,
                               std::string& resultString) {
-  vector<int>& counters (decodeMiddleCounters);
+  Counters& counters (decodeMiddleCounters);
   counters.clear();
   counters.resize(4);
-  int end = row->getSize();
+  int end = row.getSize();
   int rowOffset = startRange[1];
 
   int lgPatternFound = 0;
 
   for (int x = 0; x < 6 && rowOffset < end; x++) {
     int bestMatch = decodeDigit(row, counters, rowOffset, L_AND_G_PATTERNS);
+    if (bestMatch < 0) {
+      return -1;
+    }
     resultString.append(1, (char) ('0' + bestMatch % 10));
     for (int i = 0, end = counters.size(); i <end; i++) {
       rowOffset += counters[i];
@@ -53,14 +56,22 @@ int EAN13Reader::decodeMiddle(Ref<BitArray> row,
     }
   }
   
-  determineFirstDigit(resultString, lgPatternFound);
+  if (!determineFirstDigit(resultString, lgPatternFound)) {
+    return -1;
+  }
   
   Range middleRange = findGuardPattern(row, rowOffset, true, MIDDLE_PATTERN) ;
+  if (!middleRange.isValid()) {
+    return -1;
+  }
   rowOffset = middleRange[1];
 
   for (int x = 0; x < 6 && rowOffset < end; x++) {
     int bestMatch =
       decodeDigit(row, counters, rowOffset, L_PATTERNS);
+    if (bestMatch < 0) {
+      return -1;
+    }
     resultString.append(1, (char) ('0' + bestMatch));
     for (int i = 0, end = counters.size(); i < end; i++) {
       rowOffset += counters[i];
@@ -69,7 +80,7 @@ int EAN13Reader::decodeMiddle(Ref<BitArray> row,
   return rowOffset;
 }
 
-void EAN13Reader::determineFirstDigit(std::string& resultString, int lgPatternFound) {
+bool EAN13Reader::determineFirstDigit(std::string& resultString, int lgPatternFound) {
   // std::cerr << "K " << resultString << " " << lgPatternFound << " " <<FIRST_DIGIT_ENCODINGS << std::endl;
   for (int d = 0; d < 10; d++) {
     if (lgPatternFound == FIRST_DIGIT_ENCODINGS[d]) {
@@ -79,10 +90,10 @@ void EAN13Reader::determineFirstDigit(std::string& resultString, int lgPatternFo
 #else                   //
       resultString.insert(0, 1, (char) ('0' + d));
 #endif                  //
-      return;
+      return true;
     }
   }
-  throw NotFoundException();
+  return false;
 }
 
 zxing::BarcodeFormat EAN13Reader::getBarcodeFormat(){
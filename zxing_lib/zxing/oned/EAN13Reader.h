@@ -29,14 +29,14 @@ namespace oned {
 
 class EAN13Reader : public UPCEANReader {
 private:
-  std::vector<int> decodeMiddleCounters;
-  static void determineFirstDigit(std::string& resultString,
+  Counters decodeMiddleCounters;
+  static bool determineFirstDigit(std::string& resultString,
                                   int lgPatternFound);
 
 public:
   EAN13Reader();
 
-  int decodeMiddle(Ref<BitArray> row,
+  int decodeMiddle(RunLengthRow const& row,
                    Range const& startRange,
                    std::string& resultString);
 
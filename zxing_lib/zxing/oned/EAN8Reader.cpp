@@ -23,24 +23,27 @@ using zxing::oned::EAN8Reader;
 
 // VC++
 using zxing::Ref;
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
-EAN8Reader::EAN8Reader() : decodeMiddleCounters(4, 0) {}
+EAN8Reader::EAN8Reader() : decodeMiddleCounters(4) {}
 
-int EAN8Reader::decodeMiddle(Ref<BitArray> row,
+int EAN8Reader::decodeMiddle(RunLengthRow const& row,
                              Range const& startRange,
                              std::string& result){
-  vector<int>& counters (decodeMiddleCounters);
+  Counters& counters (decodeMiddleCounters);
   counters[0] = 0;
   counters[1] = 0;
   counters[2] = 0;
   counters[3] = 0;
 
-  int end = row->getSize();
+  int end = row.getSize();
   int rowOffset = startRange[1];
 
   for (int x = 0; x < 4 && rowOffset < end; x++) {
     int bestMatch = decodeDigit(row, counters, rowOffset, L_PATTERNS);
+    if (bestMatch < 0) {
+      return -1;
+    }
     result.append(1, (char) ('0' + bestMatch));
     for (int i = 0, end = counters.size(); i < end; i++) {
       rowOffset += counters[i];
@@ -49,9 +52,15 @@ int EAN8Reader::decodeMiddle(Ref<BitArray> row,
 
   Range middleRange =
     findGuardPattern(row, rowOffset, true, MIDDLE_PATTERN);
+  if (!middleRange.isValid()) {
+    return -1;
+  }
   rowOffset = middleRange[1];
   for (int x = 0; x < 4 && rowOffset < end; x++) {
     int bestMatch = decodeDigit(row, counters, rowOffset, L_PATTERNS);
+    if (bestMatch < 0) {
+      return -1;
+    }
     result.append(1, (char) ('0' + bestMatch));
     for (int i = 0, end = counters.size(); i < end; i++) {
       rowOffset += counters[i];
@@ -29,12 +29,12 @@ namespace oned {
 
 class EAN8Reader : public UPCEANReader {
  private:
-  std::vector<int> decodeMiddleCounters;
+  Counters decodeMiddleCounters;
 
  public:
   EAN8Reader();
 
-  int decodeMiddle(Ref<BitArray> row,
+  int decodeMiddle(RunLengthRow const& row,
                    Range const& startRange,
                    std::string& resultString);
 
@@ -34,7 +34,7 @@ using zxing::NotFoundException;
 using zxing::oned::ITFReader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 #define VECTOR_INIT(v) v, v + sizeof(v)/sizeof(v[0])
 
@@ -45,7 +45,13 @@ const int N = 1; // Pixed width of a narrow line
 
 const int DEFAULT_ALLOWED_LENGTHS_[] =
 { 48, 44, 24, 20, 18, 16, 14, 12, 10, 8, 6 };
-const ArrayRef<int> DEFAULT_ALLOWED_LENGTHS (new Array<int>(VECTOR_INIT(DEFAULT_ALLOWED_LENGTHS_)));
+// Shared by every reader, possibly on different threads.
+ArrayRef<int> makeDefaultAllowedLengths() {
+  ArrayRef<int> lengths (new Array<int>(VECTOR_INIT(DEFAULT_ALLOWED_LENGTHS_)));
+  lengths->markShared();
+  return lengths;
+}
+const ArrayRef<int> DEFAULT_ALLOWED_LENGTHS (makeDefaultAllowedLengths());
 
 /**
  * Start/end guard pattern.
@@ -81,14 +87,22 @@ ITFReader::ITFReader() : narrowLineWidth(-1) {
 }
 
 
-Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> ITFReader::decodeRuns(int rowNumber, RunLengthRow const& row) {
   // Find out where the Middle section (payload) starts & ends
 
   Range startRange = decodeStart(row);
+  if (!startRange.isValid()) {
+    return Ref<Result>();
+  }
   Range endRange = decodeEnd(row);
+  if (!endRange.isValid()) {
+    return Ref<Result>();
+  }
 
   std::string result;
-  decodeMiddle(row, startRange[1], endRange[0], result);
+  if (!decodeMiddle(row, startRange[1], endRange[0], result)) {
+    return Ref<Result>();
+  }
   Ref<String> resultString(new String(result));
 
   ArrayRef<int> allowedLengths;
@@ -109,7 +123,7 @@ Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row) {
   }
 
   if (!lengthOK) {
-    throw FormatException();
+    return Ref<Result>();
   }
 
   ArrayRef< Ref<ResultPoint> > resultPoints(2);
@@ -124,9 +138,9 @@ Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row) {
  * @param row          row of black/white values to search
  * @param payloadStart offset of start pattern
  * @param resultString {@link StringBuffer} to append decoded chars to
- * @throws ReaderException if decoding could not complete successfully
+ * @return false if decoding could not complete successfully
  */
-void ITFReader::decodeMiddle(Ref<BitArray> row,
+bool ITFReader::decodeMiddle(RunLengthRow const& row,
                              int payloadStart,
                              int payloadEnd,
                              std::string& resultString) {
@@ -135,14 +149,16 @@ void ITFReader::decodeMiddle(Ref<BitArray> row,
   // interleaved white lines for the second digit.
   // Therefore, need to scan 10 lines and then
   // split these into two arrays
-  vector<int> counterDigitPair(10, 0);
-  vector<int> counterBlack(5, 0);
-  vector<int> counterWhite(5, 0);
+  Counters counterDigitPair(10);
+  Counters counterBlack(5);
+  Counters counterWhite(5);
 
   while (payloadStart < payloadEnd) {
 
     // Get 10 runs of black/white.
-    recordPattern(row, payloadStart, counterDigitPair);
+    if (!tryRecordPattern(row, payloadStart, counterDigitPair)) {
+      return false;
+    }
     // Split them into each array
     for (int k = 0; k < 5; k++) {
       int twoK = k << 1;
@@ -151,14 +167,21 @@ void ITFReader::decodeMiddle(Ref<BitArray> row,
     }
 
     int bestMatch = decodeDigit(counterBlack);
+    if (bestMatch < 0) {
+      return false;
+    }
     resultString.append(1, (char) ('0' + bestMatch));
     bestMatch = decodeDigit(counterWhite);
+    if (bestMatch < 0) {
+      return false;
+    }
     resultString.append(1, (char) ('0' + bestMatch));
 
     for (int i = 0, e = counterDigitPair.size(); i < e; i++) {
       payloadStart += counterDigitPair[i];
     }
   }
+  return true;
 }
 
 /**
@@ -166,19 +189,26 @@ void ITFReader::decodeMiddle(Ref<BitArray> row,
  *
  * @param row row of black/white values to search
  * @return Array, containing index of start of 'start block' and end of
- *         'start block'
- * @throws ReaderException
+ *         'start block', or an invalid Range if there is none
  */
-ITFReader::Range ITFReader::decodeStart(Ref<BitArray> row) {
+ITFReader::Range ITFReader::decodeStart(RunLengthRow const& row) {
   int endStart = skipWhiteSpace(row);
+  if (endStart < 0) {
+    return Range();
+  }
   Range startPattern = findGuardPattern(row, endStart, START_PATTERN);
+  if (!startPattern.isValid()) {
+    return startPattern;
+  }
 
   // Determine the width of a narrow line in pixels. We can do this by
   // getting the width of the start pattern and dividing by 4 because its
   // made up of 4 narrow lines.
   narrowLineWidth = (startPattern[1] - startPattern[0]) >> 2;
 
-  validateQuietZone(row, startPattern[0]);
+  if (!validateQuietZone(row, startPattern[0])) {
+    return Range();
+  }
   return startPattern;
 }
 
@@ -187,29 +217,37 @@ ITFReader::Range ITFReader::decodeStart(Ref<BitArray> row) {
  *
  * @param row row of black/white values to search
  * @return Array, containing index of start of 'end block' and end of 'end
- *         block'
- * @throws ReaderException
+ *         block', or an invalid Range if there is none
  */
 
-ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> row) {
+ITFReader::Range ITFReader::decodeEnd(RunLengthRow const& row) {
   // For convenience, reverse the row and then
   // search from 'the start' for the end block
-  BitArray::Reverse r (row);
+  RunLengthRow reversed;
+  reversed.setReversed(row);
 
-  int endStart = skipWhiteSpace(row);
-  Range endPattern = findGuardPattern(row, endStart, END_PATTERN_REVERSED);
+  int endStart = skipWhiteSpace(reversed);
+  if (endStart < 0) {
+    return Range();
+  }
+  Range endPattern = findGuardPattern(reversed, endStart, END_PATTERN_REVERSED);
+  if (!endPattern.isValid()) {
+    return endPattern;
+  }
 
   // The start & end patterns must be pre/post fixed by a quiet zone. This
   // zone must be at least 10 times the width of a narrow line.
   // ref: http://www.barcode-1.net/i25code.html
-  validateQuietZone(row, endPattern[0]);
+  if (!validateQuietZone(reversed, endPattern[0])) {
+    return Range();
+  }
 
   // Now recalculate the indices of where the 'endblock' starts & stops to
   // accommodate
   // the reversed nature of the search
   int temp = endPattern[0];
-  endPattern[0] = row->getSize() - endPattern[1];
-  endPattern[1] = row->getSize() - temp;
+  endPattern[0] = row.getSize() - endPattern[1];
+  endPattern[1] = row.getSize() - temp;
   
   return endPattern;
 }
@@ -227,35 +265,28 @@ ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> row) {
  *
  * @param row bit array representing the scanned barcode.
  * @param startPattern index into row of the start or end pattern.
- * @throws ReaderException if the quiet zone cannot be found, a ReaderException is thrown.
+ * @return false if the quiet zone cannot be found.
  */
-void ITFReader::validateQuietZone(Ref<BitArray> row, int startPattern) {
+bool ITFReader::validateQuietZone(RunLengthRow const& row, int startPattern) {
   int quietCount = this->narrowLineWidth * 10;  // expect to find this many pixels of quiet zone
 
-  for (int i = startPattern - 1; quietCount > 0 && i >= 0; i--) {
-    if (row->get(i)) {
-      break;
-    }
-    quietCount--;
-  }
-  if (quietCount != 0) {
-    // Unable to find the necessary number of quiet zone pixels.
-    throw NotFoundException();
-  }
+  // Unable to find the necessary number of quiet zone pixels otherwise.
+  return quietCount == 0 ||
+    (startPattern >= quietCount && row.isRange(startPattern - quietCount, startPattern, false));
 }
 
 /**
  * Skip all whitespace until we get to the first black line.
  *
  * @param row row of black/white values to search
- * @return index of the first black line.
- * @throws ReaderException Throws exception if no black lines are found in the row
+ * @return index of the first black line, or -1 if no black lines are found
+ *         in the row
  */
-int ITFReader::skipWhiteSpace(Ref<BitArray> row) {
-  int width = row->getSize();
-  int endStart = row->getNextSet(0);
+int ITFReader::skipWhiteSpace(RunLengthRow const& row) {
+  int width = row.getSize();
+  int endStart = row.getNextSet(0);
   if (endStart == width) {
-    throw NotFoundException();
+    return -1;
   }
   return endStart;
 }
@@ -266,44 +297,30 @@ int ITFReader::skipWhiteSpace(Ref<BitArray> row) {
  * @param pattern   pattern of counts of number of black and white pixels that are
  *                  being searched for as a pattern
  * @return start/end horizontal offset of guard pattern, as an array of two
- *         ints
- * @throws ReaderException if pattern is not found
+ *         ints, or an invalid Range if pattern is not found
  */
-ITFReader::Range ITFReader::findGuardPattern(Ref<BitArray> row,
+ITFReader::Range ITFReader::findGuardPattern(RunLengthRow const& row,
                                              int rowOffset,
                                              vector<int> const& pattern) {
   // TODO: This is very similar to implementation in UPCEANReader. Consider if they can be
   // merged to a single method.
   int patternLength = pattern.size();
-  vector<int> counters(patternLength);
-  int width = row->getSize();
-  bool isWhite = false;
-
-  int counterPosition = 0;
+  Counters counters(patternLength);
+  // rowOffset is on a bar, which the first counter may begin part way into.
+  // Slide a pattern-sized window along the runs from there, two at a time.
+  int run = row.getRunAt(rowOffset);
   int patternStart = rowOffset;
-  for (int x = rowOffset; x < width; x++) {
-    if (row->get(x) ^ isWhite) {
-      counters[counterPosition]++;
-    } else {
-      if (counterPosition == patternLength - 1) {
-        if (patternMatchVariance(counters, &pattern[0], MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
-          return Range(patternStart, x);
-        }
-        patternStart += counters[0] + counters[1];
-        for (int y = 2; y < patternLength; y++) {
-          counters[y - 2] = counters[y];
-        }
-        counters[patternLength - 2] = 0;
-        counters[patternLength - 1] = 0;
-        counterPosition--;
-      } else {
-        counterPosition++;
-      }
-      counters[counterPosition] = 1;
-      isWhite = !isWhite;
+  for (; run + patternLength < row.getRunCount(); run += 2) {
+    counters[0] = row.getRunEnd(run) - patternStart;
+    for (int y = 1; y < patternLength; y++) {
+      counters[y] = row[run + y];
     }
+    if (patternMatchVariance(counters, &pattern[0], MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
+      return Range(patternStart, row.getRunStart(run + patternLength));
+    }
+    patternStart = row.getRunStart(run + 2);
   }
-  throw NotFoundException();
+  return Range();
 }
 
 /**
@@ -311,10 +328,9 @@ ITFReader::Range ITFReader::findGuardPattern(Ref<BitArray> row,
  * digit.
  *
  * @param counters the counts of runs of observed black/white/black/... values
- * @return The decoded digit
- * @throws ReaderException if digit cannot be decoded
+ * @return The decoded digit, or -1 if digit cannot be decoded
  */
-int ITFReader::decodeDigit(vector<int>& counters){
+int ITFReader::decodeDigit(Counters& counters){
 
   int bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
   int bestMatch = -1;
@@ -327,11 +343,7 @@ int ITFReader::decodeDigit(vector<int>& counters){
       bestMatch = i;
     }
   }
-  if (bestMatch >= 0) {
-    return bestMatch;
-  } else {
-    throw NotFoundException();
-  }
+  return bestMatch;
 }
 
 ITFReader::~ITFReader(){}
@@ -32,18 +32,18 @@ private:
   // Stores the actual narrow line width of the image being decoded.
   int narrowLineWidth;
 			
-  Range decodeStart(Ref<BitArray> row);
-  Range decodeEnd(Ref<BitArray> row);
-  static void decodeMiddle(Ref<BitArray> row, int payloadStart, int payloadEnd, std::string& resultString);
-  void validateQuietZone(Ref<BitArray> row, int startPattern);
-  static int skipWhiteSpace(Ref<BitArray> row);
+  Range decodeStart(RunLengthRow const& row);
+  Range decodeEnd(RunLengthRow const& row);
+  static bool decodeMiddle(RunLengthRow const& row, int payloadStart, int payloadEnd, std::string& resultString);
+  bool validateQuietZone(RunLengthRow const& row, int startPattern);
+  static int skipWhiteSpace(RunLengthRow const& row);
 			
-  static Range findGuardPattern(Ref<BitArray> row, int rowOffset, std::vector<int> const& pattern);
-  static int decodeDigit(std::vector<int>& counters);
+  static Range findGuardPattern(RunLengthRow const& row, int rowOffset, std::vector<int> const& pattern);
+  static int decodeDigit(Counters& counters);
 			
   void append(char* s, char c);
 public:
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
   ITFReader();
   ~ITFReader();
 };
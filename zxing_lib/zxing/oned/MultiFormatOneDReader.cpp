@@ -32,7 +32,7 @@ using zxing::oned::MultiFormatOneDReader;
 
 // VC++
 using zxing::DecodeHints;
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
   if (hints.containsFormat(BarcodeFormat::EAN_13) ||
@@ -80,17 +80,20 @@ MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
 
 #include <typeinfo>
 
-Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+// The row's runs are computed once by the caller and shared by all readers.
+Ref<Result> MultiFormatOneDReader::decodeRuns(int rowNumber, RunLengthRow const& row) {
   int size = readers.size();
   for (int i = 0; i < size; i++) {
     OneDReader* reader = readers[i];
     try {
-      Ref<Result> result = reader->decodeRow(rowNumber, row);
-      return result;
+      Ref<Result> result = reader->decodeRuns(rowNumber, row);
+      if (!result.empty()) {
+        return result;
+      }
     } catch (ReaderException const& re) {
       (void)re;
       // continue
     }
   }
-  throw NotFoundException();
+  return Ref<Result>();
 }
@@ -37,7 +37,7 @@ using zxing::oned::MultiFormatUPCEANReader;
     
 // VC++
 using zxing::DecodeHints;
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints) : readers() {
   if (hints.containsFormat(BarcodeFormat::EAN_13)) {
@@ -61,18 +61,24 @@ MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints) : readers()
 
 #include <typeinfo>
 
-Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> MultiFormatUPCEANReader::decodeRuns(int rowNumber, RunLengthRow const& row) {
   // Compute this location once and reuse it on multiple implementations
   UPCEANReader::Range startGuardPattern = UPCEANReader::findStartGuardPattern(row);
+  if (!startGuardPattern.isValid()) {
+    return Ref<Result>();
+  }
   for (int i = 0, e = readers.size(); i < e; i++) {
     Ref<UPCEANReader> reader = readers[i];
     Ref<Result> result;
     try {
-      result = reader->decodeRow(rowNumber, row, startGuardPattern);
+      result = reader->decodeRuns(rowNumber, row, startGuardPattern);
     } catch (ReaderException const& ignored) {
       (void)ignored;
       continue;
     }
+    if (result.empty()) {
+      continue;
+    }
 
     // Special case: a 12-digit code encoded in UPC-A is identical
     // to a "0" followed by those 12 digits encoded as EAN-13. Each
@@ -106,5 +112,5 @@ Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row)
     return result;
   }
 
-  throw NotFoundException();
+  return Ref<Result>();
 }
@@ -17,6 +17,7 @@
 
 #include <zxing/ZXing.h>
 #include <zxing/oned/OneDReader.h>
+#include <zxing/oned/ScanlineScheduler.h>
 #include <zxing/ReaderException.h>
 #include <zxing/oned/OneDResultPoint.h>
 #include <zxing/NotFoundException.h>
@@ -29,6 +30,8 @@ using zxing::Ref;
 using zxing::Result;
 using zxing::NotFoundException;
 using zxing::oned::OneDReader;
+using zxing::oned::ScanlineScheduler;
+using zxing::oned::MiddleOutScanlineScheduler;
 
 // VC++
 using zxing::BinaryBitmap;
@@ -38,16 +41,33 @@ using zxing::DecodeHints;
 OneDReader::OneDReader() {}
 
 Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  try {
-    return doDecode(image, hints);
-  } catch (NotFoundException const& nfe) {
+  Ref<Result> result = tryDecode(image, hints);
+  if (result.empty()) {
+    throw NotFoundException();
+  }
+  return result;
+}
+
+Ref<Result> OneDReader::tryDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
+  Ref<Result> result = doDecode(image, hints);
+  if (result.empty()) {
     // std::cerr << "trying harder" << std::endl;
     bool tryHarder = hints.getTryHarder();
     if (tryHarder && image->isRotateSupported()) {
       // std::cerr << "v rotate" << std::endl;
-      Ref<BinaryBitmap> rotatedImage(image->rotateCounterClockwise());
+      Ref<BinaryBitmap> rotatedImage;
+      try {
+        rotatedImage = image->rotateCounterClockwise();
+      } catch (NotFoundException const& ignored) {
+        // Too little contrast to binarize the image as a whole
+        (void)ignored;
+        return result;
+      }
       // std::cerr << "^ rotate" << std::endl;
-      Ref<Result> result = doDecode(rotatedImage, hints);
+      result = doDecode(rotatedImage, hints);
+      if (result.empty()) {
+        return result;
+      }
       // Doesn't have java metadata stuff
       ArrayRef< Ref<ResultPoint> >& points (result->getResultPoints());
       if (points && !points->empty()) {
@@ -57,54 +77,25 @@ Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
         }
       }
       // std::cerr << "tried harder" << std::endl;
-      return result;
-    } else {
-      // std::cerr << "tried harder nfe" << std::endl;
-      throw nfe;
     }
   }
+  return result;
 }
 
 #include <typeinfo>
 
 Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
   int width = image->getWidth();
-  int height = image->getHeight();
   Ref<BitArray> row(new BitArray(width));
+  RunLengthRow runs;
+  RunLengthRow reversedRuns;
 
-  int middle = height >> 1;
-  bool tryHarder = hints.getTryHarder();
-  int rowStep = std::max(1, height >> (tryHarder ? 8 : 5));
-  using namespace std;
-  // cerr << "rS " << rowStep << " " << height << " " << tryHarder << endl;
-  int maxLines;
-  if (tryHarder) {
-    maxLines = height; // Look at the whole image, not just the center
-  } else {
-    maxLines = 15; // 15 rows spaced 1/32 apart is roughly the middle half of the image
-  }
-
-  for (int x = 0; x < maxLines; x++) {
-
-    // Scanning from the middle out. Determine which row we're looking at next:
-    int rowStepsAboveOrBelow = (x + 1) >> 1;
-    bool isAbove = (x & 0x01) == 0; // i.e. is x even?
-    int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
-    if (false) {
-      std::cerr << "rN "
-                << rowNumber << " "
-                << height << " "
-                << middle << " "
-                << rowStep << " "
-                << isAbove << " "
-                << rowStepsAboveOrBelow
-                << std::endl;
-    }
-    if (rowNumber < 0 || rowNumber >= height) {
-      // Oops, if we run off the top or bottom, stop
-      break;
-    }
+  MiddleOutScanlineScheduler middleOut;
+  Ref<ScanlineScheduler> hinted (hints.getScanlineScheduler());
+  ScanlineScheduler& scheduler (hinted ? *hinted : middleOut);
+  scheduler.start(image, hints.getTryHarder());
 
+  for (int rowNumber = scheduler.nextRow(); rowNumber >= 0; rowNumber = scheduler.nextRow()) {
     // Estimate black point for this row and load it:
     try {
       row = image->getBlackRow(rowNumber, row);
@@ -113,20 +104,31 @@ Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
       continue;
     }
 
-    // While we have the image data in a BitArray, it's fairly cheap to reverse it in place to
-    // handle decoding upside down barcodes.
+    // Encode the row once. Upside down barcodes are then looked for in the
+    // mirror image of its runs, which is cheap to build and leaves the row
+    // alone.
+    runs.reset(row);
+    scheduler.rowScanned(rowNumber, runs);
     for (int attempt = 0; attempt < 2; attempt++) {
       if (attempt == 1) {
-        row->reverse(); // reverse the row and continue
+        reversedRuns.setReversed(runs); // reverse the row and continue
       }
 
       // Java hints stuff missing
 
+      Ref<Result> result;
       try {
         // Look for a barcode
         // std::cerr << "rn " << rowNumber << " " << typeid(*this).name() << std::endl;
-        Ref<Result> result = decodeRow(rowNumber, row);
+        result = decodeRuns(rowNumber, attempt == 0 ? runs : reversedRuns);
+      } catch (ReaderException const& re) {
+        // Misses come back as an empty result; this is for the rarer
+        // format and checksum errors raised after a pattern was read.
+        (void)re;
+      }
+      if (!result.empty()) {
         // We found our barcode
+        scheduler.rowDecoded(rowNumber);
         if (attempt == 1) {
           // But it was upside down, so note that
           // result.putMetadata(ResultMetadataType.ORIENTATION, new Integer(180));
@@ -141,22 +143,23 @@ Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
           }
         }
         return result;
-      } catch (ReaderException const& re) {
-        (void)re;
-        continue;
       }
     }
   }
-  throw NotFoundException();
+  return Ref<Result>();
+}
+
+Ref<Result> OneDReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
+  return decodeRuns(rowNumber, RunLengthRow(row));
 }
 
-int OneDReader::patternMatchVariance(vector<int>& counters,
+int OneDReader::patternMatchVariance(Counters& counters,
                                      vector<int> const& pattern,
                                      int maxIndividualVariance) {
   return patternMatchVariance(counters, &pattern[0], maxIndividualVariance);
 }
 
-int OneDReader::patternMatchVariance(vector<int>& counters,
+int OneDReader::patternMatchVariance(Counters& counters,
                                      int const pattern[],
                                      int maxIndividualVariance) {
   int numCounters = counters.size();
@@ -190,39 +193,58 @@ int OneDReader::patternMatchVariance(vector<int>& counters,
   return totalVariance / total;
 }
 
-void OneDReader::recordPattern(Ref<BitArray> row,
+void OneDReader::recordPattern(Ref<BitArray> const& row,
                                int start,
-                               vector<int>& counters) {
+                               Counters& counters) {
+  if (!tryRecordPattern(row, start, counters)) {
+    throw NotFoundException();
+  }
+}
+
+bool OneDReader::tryRecordPattern(Ref<BitArray> const& row,
+                                  int start,
+                                  Counters& counters) {
   int numCounters = counters.size();
   for (int i = 0; i < numCounters; i++) {
     counters[i] = 0;
   }
   int end = row->getSize();
   if (start >= end) {
-    throw NotFoundException();
+    return false;
   }
   bool isWhite = !row->get(start);
   int counterPosition = 0;
   int i = start;
-  while (i < end) {
-    if (row->get(i) ^ isWhite) { // that is, exactly one is true
-      counters[counterPosition]++;
-    } else {
-      counterPosition++;
-      if (counterPosition == numCounters) {
-        break;
-      } else {
-        counters[counterPosition] = 1;
-        isWhite = !isWhite;
-      }
+  // Measure a whole run at a time; it ends where the other colour starts.
+  while (counterPosition < numCounters) {
+    int runEnd = isWhite ? row->getNextSet(i) : row->getNextUnset(i);
+    counters[counterPosition++] = runEnd - i;
+    i = runEnd;
+    if (i == end) {
+      break;
     }
-    i++;
+    isWhite = !isWhite;
   }
   // If we read fully the last section of pixels and filled up our counters -- or filled
   // the last counter but ran off the side of the image, OK. Otherwise, a problem.
-  if (!(counterPosition == numCounters || (counterPosition == numCounters - 1 && i == end))) {
-    throw NotFoundException();
+  return counterPosition == numCounters;
+}
+
+bool OneDReader::tryRecordPattern(RunLengthRow const& row,
+                                  int start,
+                                  Counters& counters) {
+  int numCounters = counters.size();
+  int run = row.getRunAt(start);
+  // The last counter may end at the end of the row, like the others at the
+  // start of the next run.
+  if (run + numCounters > row.getRunCount()) {
+    return false;
+  }
+  counters[0] = row.getRunEnd(run) - start;
+  for (int i = 1; i < numCounters; i++) {
+    counters[i] = row[run + i];
   }
+  return true;
 }
 
 OneDReader::~OneDReader() {}
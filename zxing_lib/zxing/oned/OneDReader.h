@@ -22,6 +22,8 @@
  */
 
 #include <zxing/Reader.h>
+#include <zxing/common/SmallArray.h>
+#include <zxing/oned/RunLengthRow.h>
 
 namespace zxing {
 namespace oned {
@@ -33,11 +35,19 @@ private:
 protected:
   static const int INTEGER_MATH_SHIFT = 8;
 
+  // Run lengths of the bars and spaces of one pattern; kept inline, as
+  // patterns are rarely more than a handful of elements wide.
+  typedef SmallArray<int> Counters;
+
   struct Range {
   private:
     int data[2];
   public:
-    Range() {}
+    // A default range marks a pattern that was not found.
+    Range() {
+      data[0] = -1;
+      data[1] = -1;
+    }
     Range(int zero, int one) {
       data[0] = zero;
       data[1] = one;
@@ -48,12 +58,15 @@ protected:
     int const& operator [] (int index) const {
       return data[index];
     }
+    bool isValid() const {
+      return data[0] >= 0;
+    }
   };
 
-  static int patternMatchVariance(std::vector<int>& counters,
+  static int patternMatchVariance(Counters& counters,
                                   std::vector<int> const& pattern,
                                   int maxIndividualVariance);
-  static int patternMatchVariance(std::vector<int>& counters,
+  static int patternMatchVariance(Counters& counters,
                                   int const pattern[],
                                   int maxIndividualVariance);
 
@@ -64,14 +77,25 @@ public:
 
   OneDReader();
   virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual Ref<Result> tryDecode(Ref<BinaryBitmap> image, DecodeHints hints);
+
+  // Decodes row through decodeRuns().
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
 
   // Implementations must not throw any exceptions. If a barcode is not found on this row,
   // a empty ref should be returned e.g. return Ref<Result>();
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row) = 0;
+  virtual Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row) = 0;
 
-  static void recordPattern(Ref<BitArray> row,
+  static void recordPattern(Ref<BitArray> const& row,
                             int start,
-                            std::vector<int>& counters);
+                            Counters& counters);
+  // As recordPattern(), but returns false instead of throwing NotFoundException.
+  static bool tryRecordPattern(Ref<BitArray> const& row,
+                               int start,
+                               Counters& counters);
+  static bool tryRecordPattern(RunLengthRow const& row,
+                               int start,
+                               Counters& counters);
   virtual ~OneDReader();
 };
 
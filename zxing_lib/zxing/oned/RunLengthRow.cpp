@@ -0,0 +1,95 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/RunLengthRow.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <algorithm>
+
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::oned::RunLengthRow;
+
+RunLengthRow::RunLengthRow() : size(0), starts(1, 0) {}
+
+RunLengthRow::RunLengthRow(Ref<BitArray> const& row) : size(0) {
+  reset(row);
+}
+
+void RunLengthRow::reset(Ref<BitArray> const& row) {
+  size = row->getSize();
+  starts.clear();
+  starts.push_back(0);
+  // Each run ends where the next one, of the other colour, starts.
+  bool bar = false;
+  for (int x = 0; x < size; bar = !bar) {
+    x = bar ? row->getNextUnset(x) : row->getNextSet(x);
+    starts.push_back(x);
+  }
+}
+
+void RunLengthRow::setReversed(RunLengthRow const& row) {
+  size = row.size;
+  starts.clear();
+  starts.push_back(0);
+  int runCount = row.getRunCount();
+  if (isBar(runCount - 1)) {
+    // Mirrored, the row starts with a bar; keep the bars odd.
+    starts.push_back(0);
+  }
+  // Run i covers [size - end, size - start) once mirrored. A leading empty
+  // space becomes a trailing one, which is dropped.
+  for (int i = runCount - 1; i >= 0; i--) {
+    int end = size - row.starts[i];
+    if (end != starts.back()) {
+      starts.push_back(end);
+    }
+  }
+}
+
+int RunLengthRow::getRunAt(int x) const {
+  if (x >= size) {
+    return getRunCount();
+  }
+  return (int)(std::upper_bound(starts.begin(), starts.end(), x) - starts.begin()) - 1;
+}
+
+int RunLengthRow::getNextSet(int from) const {
+  if (from >= size) {
+    return size;
+  }
+  int run = getRunAt(from);
+  return isBar(run) ? from : starts[run + 1];
+}
+
+int RunLengthRow::getNextUnset(int from) const {
+  if (from >= size) {
+    return size;
+  }
+  int run = getRunAt(from);
+  return isBar(run) ? starts[run + 1] : from;
+}
+
+bool RunLengthRow::isRange(int start, int end, bool value) const {
+  if (end < start) {
+    throw IllegalArgumentException();
+  }
+  if (end == start) {
+    return true; // empty range matches
+  }
+  int run = getRunAt(start);
+  return run < getRunCount() && isBar(run) == value && starts[run + 1] >= end;
+}
@@ -0,0 +1,92 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RUN_LENGTH_ROW_H__
+#define __RUN_LENGTH_ROW_H__
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/BitArray.h>
+#include <vector>
+
+namespace zxing {
+namespace oned {
+
+/**
+ * A scanline as the runs of its spaces and bars. It is built once per row
+ * and shared by all the 1D readers, which match their patterns against
+ * run widths rather than walking the pixels again.
+ *
+ * Runs alternate in colour and the first one is a space, empty if the row
+ * starts with a bar, so the odd runs are the bars. Apart from that first
+ * one every run is at least a pixel wide, and the last one ends at the end
+ * of the row.
+ */
+class RunLengthRow {
+private:
+  int size;
+  // starts[i] is the first pixel of run i; starts[getRunCount()] == size.
+  std::vector<int> starts;
+
+public:
+  RunLengthRow();
+  explicit RunLengthRow(Ref<BitArray> const& row);
+
+  void reset(Ref<BitArray> const& row);
+
+  /** Makes this row the mirror image of row, without going back to the pixels. */
+  void setReversed(RunLengthRow const& row);
+
+  /** Returns the number of pixels in the row. */
+  int getSize() const {
+    return size;
+  }
+
+  int getRunCount() const {
+    return (int)starts.size() - 1;
+  }
+
+  static bool isBar(int run) {
+    return (run & 1) != 0;
+  }
+
+  int getRunStart(int run) const {
+    return starts[run];
+  }
+
+  int getRunEnd(int run) const {
+    return starts[run + 1];
+  }
+
+  /** Returns the width of run. */
+  int operator [] (int run) const {
+    return starts[run + 1] - starts[run];
+  }
+
+  /** Returns the run holding pixel x, or getRunCount() if x is past the end. */
+  int getRunAt(int x) const;
+
+  // Answer the same queries as the BitArray methods of the same names.
+  bool get(int x) const {
+    return isBar(getRunAt(x));
+  }
+  int getNextSet(int from) const;
+  int getNextUnset(int from) const;
+  bool isRange(int start, int end, bool value) const;
+};
+
+}
+}
+
+#endif
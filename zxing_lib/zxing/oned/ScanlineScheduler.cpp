@@ -0,0 +1,68 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/ScanlineScheduler.h>
+#include <algorithm>
+
+using zxing::Ref;
+using zxing::BinaryBitmap;
+using zxing::oned::RunLengthRow;
+using zxing::oned::ScanlineScheduler;
+using zxing::oned::MiddleOutScanlineScheduler;
+
+ScanlineScheduler::~ScanlineScheduler() {}
+
+void ScanlineScheduler::rowScanned(int rowNumber, RunLengthRow const& row) {
+  (void)rowNumber;
+  (void)row;
+}
+
+void ScanlineScheduler::rowDecoded(int rowNumber) {
+  (void)rowNumber;
+}
+
+MiddleOutScanlineScheduler::MiddleOutScanlineScheduler()
+  : height(0), middle(0), rowStep(1), maxLines(0), line(0) {}
+
+void MiddleOutScanlineScheduler::start(Ref<BinaryBitmap> const& image, bool tryHarder) {
+  height = image->getHeight();
+  middle = height >> 1;
+  rowStep = std::max(1, height >> (tryHarder ? 8 : 5));
+  if (tryHarder) {
+    maxLines = height; // Look at the whole image, not just the center
+  } else {
+    maxLines = 15; // 15 rows spaced 1/32 apart is roughly the middle half of the image
+  }
+  line = 0;
+}
+
+int MiddleOutScanlineScheduler::nextRow() {
+  if (line >= maxLines) {
+    return -1;
+  }
+  // Scanning from the middle out. Determine which row we're looking at next:
+  int rowStepsAboveOrBelow = (line + 1) >> 1;
+  bool isAbove = (line & 0x01) == 0; // i.e. is line even?
+  int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
+  line++;
+  if (rowNumber < 0 || rowNumber >= height) {
+    // Oops, if we run off the top or bottom, stop
+    line = maxLines;
+    return -1;
+  }
+  return rowNumber;
+}
@@ -0,0 +1,78 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __SCANLINE_SCHEDULER_H__
+#define __SCANLINE_SCHEDULER_H__
+/*
+ *  Copyright 2017 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Counted.h>
+#include <zxing/BinaryBitmap.h>
+#include <zxing/oned/RunLengthRow.h>
+
+namespace zxing {
+namespace oned {
+
+/**
+ * Decides which rows of an image the 1D readers look at, and in what
+ * order. A pass over an image starts with start(), then nextRow() is
+ * called until it returns -1 or a barcode is found. The reader reports
+ * back every row it read and the row it decoded, so a scheduler may change
+ * course as it goes and keep what it learned for the next image.
+ *
+ * A scheduler is handed to the readers through DecodeHints. As it carries
+ * state from one pass to the next, it must not be used by several decodes
+ * at once.
+ */
+class ScanlineScheduler : public Counted {
+public:
+  virtual ~ScanlineScheduler();
+
+  virtual void start(Ref<BinaryBitmap> const& image, bool tryHarder) = 0;
+
+  /** Returns the next row to read, or -1 when the pass is over. */
+  virtual int nextRow() = 0;
+
+  /** Called with the runs of each row returned by nextRow() that could be read. */
+  virtual void rowScanned(int rowNumber, RunLengthRow const& row);
+
+  /** Called when a barcode was found on rowNumber, which ends the pass. */
+  virtual void rowDecoded(int rowNumber);
+};
+
+/**
+ * The readers' standard order: rows spaced 1/32 of the height apart,
+ * middle out, the 15 nearest the middle only unless trying harder, in
+ * which case the spacing drops to 1/256 and the whole image is covered.
+ * Used when the hints name no scheduler.
+ */
+class MiddleOutScanlineScheduler : public ScanlineScheduler {
+private:
+  int height;
+  int middle;
+  int rowStep;
+  int maxLines;
+  int line;
+
+public:
+  MiddleOutScanlineScheduler();
+
+  void start(Ref<BinaryBitmap> const& image, bool tryHarder);
+  int nextRow();
+};
+
+}
+}
+
+#endif
@@ -26,34 +26,46 @@ using zxing::Ref;
 using zxing::Result;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 using zxing::BinaryBitmap;
 using zxing::DecodeHints;
 using zxing::FormatException;
 
 UPCAReader::UPCAReader() : ean13Reader() {}
 
-Ref<Result> UPCAReader::decodeRow(int rowNumber, Ref<BitArray> row) {
-  return maybeReturnResult(ean13Reader.decodeRow(rowNumber, row));
+Ref<Result> UPCAReader::decodeRuns(int rowNumber, RunLengthRow const& row) {
+  return maybeReturnResult(ean13Reader.decodeRuns(rowNumber, row));
 }
 
-Ref<Result> UPCAReader::decodeRow(int rowNumber,
-                                  Ref<BitArray> row,
-                                  Range const& startGuardRange) {
-  return maybeReturnResult(ean13Reader.decodeRow(rowNumber, row, startGuardRange));
+Ref<Result> UPCAReader::decodeRuns(int rowNumber,
+                                   RunLengthRow const& row,
+                                   Range const& startGuardRange) {
+  return maybeReturnResult(ean13Reader.decodeRuns(rowNumber, row, startGuardRange));
 }
 
 Ref<Result> UPCAReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  return maybeReturnResult(ean13Reader.decode(image, hints));
+  Ref<Result> result = maybeReturnResult(ean13Reader.decode(image, hints));
+  if (result.empty()) {
+    throw FormatException();
+  }
+  return result;
+}
+
+Ref<Result> UPCAReader::tryDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
+  return maybeReturnResult(ean13Reader.tryDecode(image, hints));
 }
 
-int UPCAReader::decodeMiddle(Ref<BitArray> row,
+int UPCAReader::decodeMiddle(RunLengthRow const& row,
                              Range const& startRange,
                              std::string& resultString) {
   return ean13Reader.decodeMiddle(row, startRange, resultString);
 }
 
+// Returns an empty Ref if there is no result or it is not a UPC-A code.
 Ref<Result> UPCAReader::maybeReturnResult(Ref<Result> result) {
+  if (result.empty()) {
+    return result;
+  }
   const std::string& text = (result->getText())->getText();
   if (text[0] == '0') {
     Ref<String> resultString(new String(text.substr(1)));
@@ -61,7 +73,7 @@ Ref<Result> UPCAReader::maybeReturnResult(Ref<Result> result) {
                                BarcodeFormat::UPC_A));
     return res;
   } else {
-    throw FormatException();
+    return Ref<Result>();
   }
 }
 
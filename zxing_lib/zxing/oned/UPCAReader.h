@@ -35,11 +35,12 @@ private:
 public:
   UPCAReader();
 
-  int decodeMiddle(Ref<BitArray> row, Range const& startRange, std::string& resultString);
+  int decodeMiddle(RunLengthRow const& row, Range const& startRange, std::string& resultString);
 
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, Range const& startGuardRange);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
+  Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row, Range const& startGuardRange);
   Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Result> tryDecode(Ref<BinaryBitmap> image, DecodeHints hints);
 
   BarcodeFormat getBarcodeFormat();
 };
@@ -37,7 +37,7 @@ using zxing::ChecksumException;
 using zxing::oned::UPCEANReader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 using zxing::String;
 
 #define LEN(v) ((int)(sizeof(v)/sizeof(v[0])))
@@ -118,36 +118,46 @@ UPCEANReader::L_AND_G_PATTERNS (VECTOR_INIT(L_AND_G_PATTERNS_));
 
 UPCEANReader::UPCEANReader() {}
 
-Ref<Result> UPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row) {
-  return decodeRow(rowNumber, row, findStartGuardPattern(row));
+Ref<Result> UPCEANReader::decodeRuns(int rowNumber, RunLengthRow const& row) {
+  Range startGuardRange = findStartGuardPattern(row);
+  if (!startGuardRange.isValid()) {
+    return Ref<Result>();
+  }
+  return decodeRuns(rowNumber, row, startGuardRange);
 }
 
-Ref<Result> UPCEANReader::decodeRow(int rowNumber,
-                                    Ref<BitArray> row,
+Ref<Result> UPCEANReader::decodeRuns(int rowNumber,
+                                    RunLengthRow const& row,
                                     Range const& startGuardRange) {
   string& result = decodeRowStringBuffer;
   result.clear();
   int endStart = decodeMiddle(row, startGuardRange, result);
+  if (endStart < 0) {
+    return Ref<Result>();
+  }
 
   Range endRange = decodeEnd(row, endStart);
+  if (!endRange.isValid()) {
+    return Ref<Result>();
+  }
 
   // Make sure there is a quiet zone at least as big as the end pattern after the barcode.
   // The spec might want more whitespace, but in practice this is the maximum we can count on.
 
   int end = endRange[1];
   int quietEnd = end + (end - endRange[0]);
-  if (quietEnd >= row->getSize() || !row->isRange(end, quietEnd, false)) {
-    throw NotFoundException();
+  if (quietEnd >= row.getSize() || !row.isRange(end, quietEnd, false)) {
+    return Ref<Result>();
   }
 
   // UPC/EAN should never be less than 8 chars anyway
   if (result.length() < 8) {
-    throw FormatException();
+    return Ref<Result>();
   }
 
   Ref<String> resultString (new String(result));
   if (!checkChecksum(resultString)) {
-    throw ChecksumException();
+    return Ref<Result>();
   }
   
   float left = (float) (startGuardRange[1] + startGuardRange[0]) / 2.0f;
@@ -161,17 +171,20 @@ Ref<Result> UPCEANReader::decodeRow(int rowNumber,
   return decodeResult;
 }
 
-UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> row) {
+UPCEANReader::Range UPCEANReader::findStartGuardPattern(RunLengthRow const& row) {
   bool foundStart = false;
   Range startRange;
   int nextStart = 0;
-  vector<int> counters(START_END_PATTERN.size(), 0);
+  Counters counters(START_END_PATTERN.size());
   // std::cerr << "fsgp " << *row << std::endl;
   while (!foundStart) {
     for(int i=0; i < (int)START_END_PATTERN.size(); ++i) {
       counters[i] = 0;
     }
     startRange = findGuardPattern(row, nextStart, false, START_END_PATTERN, counters);
+    if (!startRange.isValid()) {
+      return startRange;
+    }
     // std::cerr << "sr " << startRange[0] << " " << startRange[1] << std::endl;
     int start = startRange[0];
     nextStart = startRange[1];
@@ -180,73 +193,60 @@ UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> row) {
     // as it is very likely to be a false positive.
     int quietStart = start - (nextStart - start);
     if (quietStart >= 0) {
-      foundStart = row->isRange(quietStart, start, false);
+      foundStart = row.isRange(quietStart, start, false);
     }
   }
   return startRange;
 }
 
-UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
+UPCEANReader::Range UPCEANReader::findGuardPattern(RunLengthRow const& row,
                                                    int rowOffset,
                                                    bool whiteFirst,
                                                    vector<int> const& pattern) {
-  vector<int> counters (pattern.size(), 0);
+  Counters counters (pattern.size());
   return findGuardPattern(row, rowOffset, whiteFirst, pattern, counters);
 }
 
-UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
+UPCEANReader::Range UPCEANReader::findGuardPattern(RunLengthRow const& row,
                                                    int rowOffset,
                                                    bool whiteFirst,
                                                    vector<int> const& pattern,
-                                                   vector<int>& counters) {
-  // cerr << "fGP " << rowOffset  << " " << whiteFirst << endl;
-  if (false) {
-    for(int i=0; i < (int)pattern.size(); ++i) {
-      std::cerr << pattern[i];
-    }
-    std::cerr << std::endl;
-  }
+                                                   Counters& counters) {
   int patternLength = pattern.size();
-  int width = row->getSize();
-  bool isWhite = whiteFirst;
-  rowOffset = whiteFirst ? row->getNextUnset(rowOffset) : row->getNextSet(rowOffset);
-  int counterPosition = 0;
+  // Start at the first run of the pattern's leading colour. The first
+  // counter may begin part way into it.
+  int run = row.getRunAt(rowOffset);
+  if (run < row.getRunCount() && RunLengthRow::isBar(run) == whiteFirst) {
+    rowOffset = row.getRunStart(++run);
+  }
   int patternStart = rowOffset;
-  for (int x = rowOffset; x < width; x++) {
-    // std::cerr << "rg " << x << " " << row->get(x) << std::endl;
-    if (row->get(x) ^ isWhite) {
-      counters[counterPosition]++;
-    } else {
-      if (counterPosition == patternLength - 1) {
-        if (patternMatchVariance(counters, pattern, MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
-          return Range(patternStart, x);
-        }
-        patternStart += counters[0] + counters[1];
-        for (int y = 2; y < patternLength; y++) {
-          counters[y - 2] = counters[y];
-        }
-        counters[patternLength - 2] = 0;
-        counters[patternLength - 1] = 0;
-        counterPosition--;
-      } else {
-        counterPosition++;
-      }
-      counters[counterPosition] = 1;
-      isWhite = !isWhite;
+  // Slide a pattern-sized window along the runs, two at a time so it keeps
+  // starting on the same colour. A window ending at the end of the row is
+  // not tried.
+  for (; run + patternLength < row.getRunCount(); run += 2) {
+    counters[0] = row.getRunEnd(run) - patternStart;
+    for (int i = 1; i < patternLength; i++) {
+      counters[i] = row[run + i];
+    }
+    if (patternMatchVariance(counters, pattern, MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
+      return Range(patternStart, row.getRunStart(run + patternLength));
     }
+    patternStart = row.getRunStart(run + 2);
   }
-  throw NotFoundException();
+  return Range();
 }
 
-UPCEANReader::Range UPCEANReader::decodeEnd(Ref<BitArray> row, int endStart) {
+UPCEANReader::Range UPCEANReader::decodeEnd(RunLengthRow const& row, int endStart) {
   return findGuardPattern(row, endStart, false, START_END_PATTERN);
 }
 
-int UPCEANReader::decodeDigit(Ref<BitArray> row,
-                              vector<int> & counters,
+int UPCEANReader::decodeDigit(RunLengthRow const& row,
+                              Counters& counters,
                               int rowOffset,
                               vector<int const*> const& patterns) {
-  recordPattern(row, rowOffset, counters);
+  if (!tryRecordPattern(row, rowOffset, counters)) {
+    return -1;
+  }
   int bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
   int bestMatch = -1;
   int max = patterns.size();
@@ -258,11 +258,7 @@ int UPCEANReader::decodeDigit(Ref<BitArray> row,
       bestMatch = i;
     }
   }
-  if (bestMatch >= 0) {
-    return bestMatch;
-  } else {
-    throw NotFoundException();
-  }
+  return bestMatch;
 }
 
 /**
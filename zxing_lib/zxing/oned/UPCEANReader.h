@@ -34,17 +34,19 @@ class UPCEANReader : public OneDReader {
   static const int MAX_AVG_VARIANCE;
   static const int MAX_INDIVIDUAL_VARIANCE;
 
-  static Range findStartGuardPattern(Ref<BitArray> row);
+  // Rather than throwing when nothing matches, the guard pattern finders
+  // return an invalid Range and decodeMiddle() and decodeDigit() return -1.
+  static Range findStartGuardPattern(RunLengthRow const& row);
 
-  virtual Range decodeEnd(Ref<BitArray> row, int endStart);
+  virtual Range decodeEnd(RunLengthRow const& row, int endStart);
 
   static bool checkStandardUPCEANChecksum(Ref<String> const& s);
 
-  static Range findGuardPattern(Ref<BitArray> row,
+  static Range findGuardPattern(RunLengthRow const& row,
                                 int rowOffset,
                                 bool whiteFirst,
                                 std::vector<int> const& pattern,
-                                std::vector<int>& counters);
+                                Counters& counters);
 
 
 protected:
@@ -54,7 +56,7 @@ protected:
   static const std::vector<int const*> L_PATTERNS;
   static const std::vector<int const*> L_AND_G_PATTERNS;
 
-  static Range findGuardPattern(Ref<BitArray> row,
+  static Range findGuardPattern(RunLengthRow const& row,
                                 int rowOffset,
                                 bool whiteFirst,
                                 std::vector<int> const& pattern);
@@ -62,15 +64,15 @@ protected:
 public:
   UPCEANReader();
 
-  virtual int decodeMiddle(Ref<BitArray> row,
+  virtual int decodeMiddle(RunLengthRow const& row,
                            Range const& startRange,
                            std::string& resultString) = 0;
 
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, Range const& range);
+  virtual Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row);
+  virtual Ref<Result> decodeRuns(int rowNumber, RunLengthRow const& row, Range const& range);
 
-  static int decodeDigit(Ref<BitArray> row,
-                         std::vector<int>& counters,
+  static int decodeDigit(RunLengthRow const& row,
+                         Counters& counters,
                          int rowOffset,
                          std::vector<int const*> const& patterns);
 
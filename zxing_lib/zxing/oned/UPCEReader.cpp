@@ -26,7 +26,7 @@ using zxing::String;
 using zxing::oned::UPCEReader;
 
 // VC++
-using zxing::BitArray;
+using zxing::oned::RunLengthRow;
 
 #define VECTOR_INIT(v) v, v + sizeof(v)/sizeof(v[0])
 
@@ -53,17 +53,20 @@ namespace {
 UPCEReader::UPCEReader() {
 }
 
-int UPCEReader::decodeMiddle(Ref<BitArray> row, Range const& startRange, string& result) {
-  vector<int>& counters (decodeMiddleCounters);
+int UPCEReader::decodeMiddle(RunLengthRow const& row, Range const& startRange, string& result) {
+  Counters& counters (decodeMiddleCounters);
   counters.clear();
   counters.resize(4);
-  int end = row->getSize();
+  int end = row.getSize();
   int rowOffset = startRange[1];
 
   int lgPatternFound = 0;
 
   for (int x = 0; x < 6 && rowOffset < end; x++) {
     int bestMatch = decodeDigit(row, counters, rowOffset, L_AND_G_PATTERNS);
+    if (bestMatch < 0) {
+      return -1;
+    }
     result.append(1, (char) ('0' + bestMatch % 10));
     for (int i = 0, e = counters.size(); i < e; i++) {
       rowOffset += counters[i];
@@ -73,12 +76,14 @@ int UPCEReader::decodeMiddle(Ref<BitArray> row, Range const& startRange, string&
     }
   }
 
-  determineNumSysAndCheckDigit(result, lgPatternFound);
+  if (!determineNumSysAndCheckDigit(result, lgPatternFound)) {
+    return -1;
+  }
 
   return rowOffset;
 }
 
-UPCEReader::Range UPCEReader::decodeEnd(Ref<BitArray> row, int endStart) {
+UPCEReader::Range UPCEReader::decodeEnd(RunLengthRow const& row, int endStart) {
   return findGuardPattern(row, endStart, true, MIDDLE_END_PATTERN);
 }
 
@@ -26,16 +26,16 @@ namespace oned {
 
 class UPCEReader : public UPCEANReader {
 private:
-  std::vector<int> decodeMiddleCounters;
+  Counters decodeMiddleCounters;
   static bool determineNumSysAndCheckDigit(std::string& resultString, int lgPatternFound);
 
 protected:
-  Range decodeEnd(Ref<BitArray> row, int endStart);
+  Range decodeEnd(RunLengthRow const& row, int endStart);
   bool checkChecksum(Ref<String> const& s);
 public:
   UPCEReader();
 
-  int decodeMiddle(Ref<BitArray> row, Range const& startRange, std::string& resultString);
+  int decodeMiddle(RunLengthRow const& row, Range const& startRange, std::string& resultString);
   static Ref<String> convertUPCEtoUPCA(Ref<String> const& upce);
 
   BarcodeFormat getBarcodeFormat();
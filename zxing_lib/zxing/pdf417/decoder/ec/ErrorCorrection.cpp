@@ -49,7 +49,7 @@ void ErrorCorrection::decode(ArrayRef<int> received,
                              ArrayRef<int> erasures)
 {
   Ref<ModulusPoly> poly (new ModulusPoly(field_, received));
-  ArrayRef<int> S( new Array<int>(numECCodewords));
+  ModulusPoly::Coefficients S(numECCodewords);
   bool error = false;
   for (int i = numECCodewords; i > 0; i--) {
     int eval = poly->evaluateAt(field_.exp(i));
@@ -65,7 +65,7 @@ void ErrorCorrection::decode(ArrayRef<int> received,
     for (int i=0;i<erasures->size();i++) {
       int b = field_.exp(received->size() - 1 - erasures[i]);
       // Add (1 - bx) term:
-      ArrayRef<int> one_minus_b_x(new Array<int>(2));
+      ModulusPoly::Coefficients one_minus_b_x(2);
       one_minus_b_x[1]=field_.subtract(0,b);
       one_minus_b_x[0]=1;
       Ref<ModulusPoly> term (new ModulusPoly(field_,one_minus_b_x));
@@ -193,7 +193,7 @@ ArrayRef<int> ErrorCorrection::findErrorMagnitudes(Ref<ModulusPoly> errorEvaluat
                                                    ArrayRef<int> errorLocations) {
 	int i;
   int errorLocatorDegree = errorLocator->getDegree();
-  ArrayRef<int> formalDerivativeCoefficients (new Array<int>(errorLocatorDegree));
+  ModulusPoly::Coefficients formalDerivativeCoefficients (errorLocatorDegree);
   for (i = 1; i <= errorLocatorDegree; i++) {
     formalDerivativeCoefficients[errorLocatorDegree - i] =
         field_.multiply(i, errorLocator->getCoefficient(i));
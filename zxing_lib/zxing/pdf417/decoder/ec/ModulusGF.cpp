@@ -51,10 +51,13 @@ ModulusGF::ModulusGF(int modulus, int generator)
     logTable_[expTable_[i]] = i;
   }
   // logTable[0] == 0 but this should never be used
-	ArrayRef<int>aZero(new Array<int>(1)),aOne(new Array<int>(1));
+	ModulusPoly::Coefficients aZero(1),aOne(1);
 	aZero[0]=0;aOne[0]=1;
   zero_ = new ModulusPoly(*this, aZero);
   one_ = new ModulusPoly(*this, aOne);
+  // PDF417_GF is a static shared by every decoder thread.
+  zero_->markShared();
+  one_->markShared();
 }
  
 Ref<ModulusPoly> ModulusGF::getZero() {
@@ -74,7 +77,7 @@ Ref<ModulusPoly> ModulusGF::buildMonomial(int degree, int coefficient)
     return zero_;
   }
 	int nCoefficients = degree + 1;
-  ArrayRef<int> coefficients (new Array<int>(nCoefficients));
+  ModulusPoly::Coefficients coefficients (nCoefficients);
   coefficients[0] = coefficient;
 	Ref<ModulusPoly> result(new ModulusPoly(*this,coefficients));
   return result;
@@ -33,10 +33,20 @@ using zxing::pdf417::decoder::ec::ModulusPoly;
 ModulusPoly::ModulusPoly(ModulusGF& field, ArrayRef<int> coefficients)
     : field_(field)
 {
-  if (coefficients->size() == 0) {
+  setCoefficients(coefficients->empty() ? 0 : &coefficients[0], coefficients->size());
+}
+
+ModulusPoly::ModulusPoly(ModulusGF& field, Coefficients const& coefficients)
+    : field_(field)
+{
+  setCoefficients(coefficients.data(), coefficients.size());
+}
+
+void ModulusPoly::setCoefficients(int const* coefficients, int coefficientsLength)
+{
+  if (coefficientsLength == 0) {
     throw IllegalArgumentException("no coefficients!");
   }
-  int coefficientsLength = coefficients->size();
   if (coefficientsLength > 1 && coefficients[0] == 0) {
     // Leading term must be non-zero for anything except the constant polynomial "0"
     int firstNonZero = 1;
@@ -44,30 +54,16 @@ ModulusPoly::ModulusPoly(ModulusGF& field, ArrayRef<int> coefficients)
       firstNonZero++;
     }
     if (firstNonZero == coefficientsLength) {
-	    coefficientsLength = field_.getZero()->getCoefficients()->size();
-      coefficients_.reset(new Array<int> (coefficientsLength));
-      *coefficients_ = *(field_.getZero()->getCoefficients());
+      coefficients_ = field_.getZero()->getCoefficients();
     } else {
-      ArrayRef<int> c(coefficients);
-      coefficientsLength -= firstNonZero;
-      coefficients_.reset(new Array<int> (coefficientsLength));
-      for (int i = 0; i < coefficientsLength; i++) {
-        coefficients_[i] = c[i + firstNonZero];
-      }
-      /*
-        coefficientsLength -= firstNonZero;
-        coefficients_.reset(new Array<int>(coefficientsLength - firstNonZero));
-        for (int i = 0; i < coefficientsLength; i++) {
-        coefficients_[i] = coefficients[i + firstNonZero];
-        }
-      */
+      coefficients_ = Coefficients(coefficients + firstNonZero, coefficientsLength - firstNonZero);
     }
   } else {
-    coefficients_ = coefficients;
+    coefficients_ = Coefficients(coefficients, coefficientsLength);
   }
 }
 
-ArrayRef<int> ModulusPoly::getCoefficients() {
+ModulusPoly::Coefficients& ModulusPoly::getCoefficients() {
   return coefficients_;
 }
 
@@ -75,7 +71,7 @@ ArrayRef<int> ModulusPoly::getCoefficients() {
  * @return degree of this polynomial
  */
 int ModulusPoly::getDegree() {
-  return coefficients_->size() - 1;
+  return coefficients_.size() - 1;
 }
 
 /**
@@ -89,7 +85,7 @@ bool ModulusPoly::isZero() {
  * @return coefficient of x^degree term in this polynomial
  */
 int ModulusPoly::getCoefficient(int degree) {
-  return coefficients_[coefficients_->size() - 1 - degree];
+  return coefficients_[coefficients_.size() - 1 - degree];
 }
 
 /**
@@ -101,7 +97,7 @@ int ModulusPoly::evaluateAt(int a) {
     // Just return the x^0 coefficient
     return getCoefficient(0);
   }
-  int size = coefficients_->size();
+  int size = coefficients_.size();
   if (a == 1) {
     // Just the sum of the coefficients
     int result = 0;
@@ -128,22 +124,22 @@ Ref<ModulusPoly> ModulusPoly::add(Ref<ModulusPoly> other) {
     return Ref<ModulusPoly>(this);
   }
 
-  ArrayRef<int> smallerCoefficients = coefficients_;
-  ArrayRef<int> largerCoefficients = other->coefficients_;
+  Coefficients const* smallerCoefficients = &coefficients_;
+  Coefficients const* largerCoefficients = &other->coefficients_;
   if (smallerCoefficients->size() > largerCoefficients->size()) {
-    ArrayRef<int> temp(smallerCoefficients);
+    Coefficients const* temp = smallerCoefficients;
     smallerCoefficients = largerCoefficients;
     largerCoefficients = temp;
   }
-  ArrayRef<int>  sumDiff (new Array<int>(largerCoefficients->size()));
+  Coefficients sumDiff (largerCoefficients->size());
   int lengthDiff = largerCoefficients->size() - smallerCoefficients->size();
   // Copy high-order terms only found in higher-degree polynomial's coefficients
 	for (int i = 0; i < lengthDiff; i++) {
-		sumDiff[i] = largerCoefficients[i];
+		sumDiff[i] = (*largerCoefficients)[i];
 	}
 
   for (int i = lengthDiff; i < largerCoefficients->size(); i++) {
-    sumDiff[i] = field_.add(smallerCoefficients[i - lengthDiff], largerCoefficients[i]);
+    sumDiff[i] = field_.add((*smallerCoefficients)[i - lengthDiff], (*largerCoefficients)[i]);
   }
 
   return Ref<ModulusPoly>(new ModulusPoly(field_, sumDiff));
@@ -167,11 +163,11 @@ Ref<ModulusPoly> ModulusPoly::multiply(Ref<ModulusPoly> other) {
     return field_.getZero();
   }
 	int i,j;
-  ArrayRef<int> aCoefficients = coefficients_;
-  int aLength = aCoefficients->size();
-  ArrayRef<int> bCoefficients = other->coefficients_;
-  int bLength = bCoefficients->size();
-  ArrayRef<int> product (new Array<int>(aLength + bLength - 1));
+  Coefficients const& aCoefficients = coefficients_;
+  int aLength = aCoefficients.size();
+  Coefficients const& bCoefficients = other->coefficients_;
+  int bLength = bCoefficients.size();
+  Coefficients product (aLength + bLength - 1);
   for (i = 0; i < aLength; i++) {
     int aCoeff = aCoefficients[i];
     for (j = 0; j < bLength; j++) {
@@ -182,8 +178,8 @@ Ref<ModulusPoly> ModulusPoly::multiply(Ref<ModulusPoly> other) {
 }
 
 Ref<ModulusPoly> ModulusPoly::negative() {
-  int size = coefficients_->size();
-  ArrayRef<int> negativeCoefficients (new Array<int>(size));
+  int size = coefficients_.size();
+  Coefficients negativeCoefficients (size);
   for (int i = 0; i < size; i++) {
     negativeCoefficients[i] = field_.subtract(0, coefficients_[i]);
   }
@@ -197,8 +193,8 @@ Ref<ModulusPoly> ModulusPoly::multiply(int scalar) {
   if (scalar == 1) {
     return Ref<ModulusPoly>(this);
   }
-  int size = coefficients_->size();
-  ArrayRef<int> product( new Array<int>(size));
+  int size = coefficients_.size();
+  Coefficients product (size);
   for (int i = 0; i < size; i++) {
     product[i] = field_.multiply(coefficients_[i], scalar);
   }
@@ -212,8 +208,8 @@ Ref<ModulusPoly> ModulusPoly::multiplyByMonomial(int degree, int coefficient) {
   if (coefficient == 0) {
     return field_.getZero();
   }
-  int size = coefficients_->size();
-  ArrayRef<int> product (new Array<int>(size + degree));
+  int size = coefficients_.size();
+  Coefficients product (size + degree);
   for (int i = 0; i < size; i++) {
     product[i] = field_.multiply(coefficients_[i], coefficient);
   }
@@ -20,7 +20,9 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/SmallArray.h>
 #include <zxing/common/DecoderResult.h>
 #include <zxing/common/BitMatrix.h>
 
@@ -35,15 +37,20 @@ class ModulusGF;
  * @author Sean Owen
  * @see com.google.zxing.common.reedsolomon.GenericGFPoly
  */
-class ModulusPoly: public Counted {
+class ModulusPoly: public Counted, public ArenaAllocated {
 
+  public:
+	typedef SmallArray<int, 32> Coefficients;
   private:
 	ModulusGF &field_;
-	ArrayRef<int> coefficients_;
+	Coefficients coefficients_;
+
+	void setCoefficients(int const* coefficients, int coefficientsLength);
   public:
 	ModulusPoly(ModulusGF& field, ArrayRef<int> coefficients);
+	ModulusPoly(ModulusGF& field, Coefficients const& coefficients);
 	~ModulusPoly();
-	ArrayRef<int> getCoefficients();
+	Coefficients& getCoefficients();
 	int getDegree();
 	bool isZero();
 	int getCoefficient(int degree);
@@ -120,7 +120,8 @@ Version *Version::getVersionForNumber(int versionNumber) {
 
 Version::Version(int versionNumber, vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
                  ECBlocks *ecBlocks3, ECBlocks *ecBlocks4) :
-    versionNumber_(versionNumber), alignmentPatternCenters_(*alignmentPatternCenters), ecBlocks_(4), totalCodewords_(0) {
+    versionNumber_(versionNumber), alignmentPatternCenters_(*alignmentPatternCenters), ecBlocks_(4), totalCodewords_(0),
+    layout_(0) {
   ecBlocks_[0] = ecBlocks1;
   ecBlocks_[1] = ecBlocks2;
   ecBlocks_[2] = ecBlocks3;
@@ -137,6 +138,7 @@ Version::Version(int versionNumber, vector<int> *alignmentPatternCenters, ECBloc
 }
 
 Version::~Version() {
+  delete layout_;
   delete &alignmentPatternCenters_;
   for (size_t i = 0; i < ecBlocks_.size(); i++) {
     delete ecBlocks_[i];
@@ -210,6 +212,50 @@ Ref<BitMatrix> Version::buildFunctionPattern() {
   return functionPattern;
 }
 
+CodewordLayout const& Version::getCodewordLayout() {
+  CodewordLayout *layout = detail::loadShared(&layout_);
+  if (!layout) {
+    // Threads racing to build it each make one; all but the first to
+    // publish throw theirs away.
+    CodewordLayout *built = new CodewordLayout(*this);
+    layout = detail::publishShared(&layout_, built);
+    if (layout != built) {
+      delete built;
+    }
+  }
+  return *layout;
+}
+
+CodewordLayout::CodewordLayout(Version& version) :
+    functionPattern_(version.buildFunctionPattern()) {
+  functionPattern_->markShared();
+  int dimension = version.getDimensionForVersion();
+  size_t totalBits = version.getTotalCodewords() * 8;
+  bitPositions_.reserve(totalBits);
+
+  bool readingUp = true;
+  // Read columns in pairs, from right to left
+  for (int x = dimension - 1; x > 0; x -= 2) {
+    if (x == 6) {
+      // Skip whole column with vertical alignment pattern;
+      // saves time and makes the other code proceed more cleanly
+      x--;
+    }
+    // Read alternatingly from bottom to top then top to bottom
+    for (int counter = 0; counter < dimension; counter++) {
+      int y = readingUp ? dimension - 1 - counter : counter;
+      for (int col = 0; col < 2; col++) {
+        // Ignore bits covered by the function pattern, and the remainder
+        // bits after the last codeword
+        if (!functionPattern_->get(x - col, y) && bitPositions_.size() < totalBits) {
+          bitPositions_.push_back((unsigned short)((x - col) | (y << 8)));
+        }
+      }
+    }
+    readingUp = !readingUp; // switch directions
+  }
+}
+
 static vector<int> *intArray(size_t n...) {
   va_list ap;
   va_start(ap, n);
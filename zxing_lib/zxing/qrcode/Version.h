@@ -52,6 +52,35 @@ public:
   ~ECBlocks();
 };
 
+class Version;
+
+/**
+ * Where a version's codeword bits lie in the symbol, in the order they are
+ * read, along with the version's function pattern. It is built on first
+ * use and never changed afterwards, so any number of threads may read it.
+ */
+class CodewordLayout {
+private:
+  Ref<BitMatrix> functionPattern_;
+  // x | y << 8 of each module holding a codeword bit, most significant bit
+  // of the first codeword first
+  std::vector<unsigned short> bitPositions_;
+
+  CodewordLayout(const CodewordLayout&);
+  CodewordLayout& operator =(const CodewordLayout&);
+
+public:
+  explicit CodewordLayout(Version& version);
+
+  // Shared; must not be modified.
+  Ref<BitMatrix> getFunctionPattern() const {
+    return functionPattern_;
+  }
+  std::vector<unsigned short> const& getBitPositions() const {
+    return bitPositions_;
+  }
+};
+
 class Version : public Counted {
 
 private:
@@ -59,6 +88,7 @@ private:
   std::vector<int> &alignmentPatternCenters_;
   std::vector<ECBlocks*> ecBlocks_;
   int totalCodewords_;
+  CodewordLayout *layout_;
   Version(int versionNumber, std::vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
           ECBlocks *ecBlocks3, ECBlocks *ecBlocks4);
 
@@ -77,6 +107,7 @@ public:
   static Version *getVersionForNumber(int versionNumber);
   static Version *decodeVersionInformation(unsigned int versionBits);
   Ref<BitMatrix> buildFunctionPattern();
+  CodewordLayout const& getCodewordLayout();
   static int buildVersions();
 };
 }
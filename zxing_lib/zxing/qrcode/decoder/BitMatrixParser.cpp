@@ -129,53 +129,23 @@ ArrayRef<char> BitMatrixParser::readCodewords() {
   dataMask.unmaskBitMatrix(*bitMatrix_, dimension);
 
 
-  //		cerr << *bitMatrix_ << endl;
-  //	cerr << version->getTotalCodewords() << endl;
-
-  Ref<BitMatrix> functionPattern = version->buildFunctionPattern();
-
-
-  //	cout << *functionPattern << endl;
-
-  bool readingUp = true;
-  ArrayRef<char> result(version->getTotalCodewords());
-  int resultOffset = 0;
-  int currentByte = 0;
-  int bitsRead = 0;
-  // Read columns in pairs, from right to left
-  for (int x = dimension - 1; x > 0; x -= 2) {
-    if (x == 6) {
-      // Skip whole column with vertical alignment pattern;
-      // saves time and makes the other code proceed more cleanly
-      x--;
-    }
-    // Read alternatingly from bottom to top then top to bottom
-    for (int counter = 0; counter < dimension; counter++) {
-      int y = readingUp ? dimension - 1 - counter : counter;
-      for (int col = 0; col < 2; col++) {
-        // Ignore bits covered by the function pattern
-        if (!functionPattern->get(x - col, y)) {
-          // Read a bit
-          bitsRead++;
-          currentByte <<= 1;
-          if (bitMatrix_->get(x - col, y)) {
-            currentByte |= 1;
-          }
-          // If we've made a whole byte, save it off
-          if (bitsRead == 8) {
-            result[resultOffset++] = (char)currentByte;
-            bitsRead = 0;
-            currentByte = 0;
-          }
-        }
-      }
-    }
-    readingUp = !readingUp; // switch directions
-  }
-
-  if (resultOffset != version->getTotalCodewords()) {
+  // The bits of every codeword, in order, are listed by the layout; this
+  // only has to gather them.
+  std::vector<unsigned short> const& positions = version->getCodewordLayout().getBitPositions();
+  int totalCodewords = version->getTotalCodewords();
+  if ((int)positions.size() != totalCodewords * 8) {
     throw ReaderException("Did not read all codewords");
   }
+  ArrayRef<char> result(totalCodewords);
+  BitMatrix const& bits = *bitMatrix_;
+  const unsigned short* position = &positions[0];
+  for (int i = 0; i < totalCodewords; i++) {
+    int currentByte = 0;
+    for (int j = 0; j < 8; j++, position++) {
+      currentByte = (currentByte << 1) | (int)bits.get(*position & 0xFF, *position >> 8);
+    }
+    result[i] = (char)currentByte;
+  }
   return result;
 }
 
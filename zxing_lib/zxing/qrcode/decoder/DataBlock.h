@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <zxing/common/Array.h>
 #include <zxing/qrcode/Version.h>
 #include <zxing/qrcode/ErrorCorrectionLevel.h>
@@ -29,7 +30,7 @@
 namespace zxing {
 namespace qrcode {
 
-class DataBlock : public Counted {
+class DataBlock : public Counted, public ArenaAllocated {
 private:
   int numDataCodewords_;
   ArrayRef<char> codewords_;
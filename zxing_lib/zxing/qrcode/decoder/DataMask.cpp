@@ -21,6 +21,7 @@
 #include <zxing/qrcode/decoder/DataMask.h>
 
 #include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/BitUtils.h>
 
 namespace zxing {
 namespace qrcode {
@@ -43,17 +44,40 @@ DataMask &DataMask::forReference(int reference) {
   return *DATA_MASKS[reference];
 }
 
-void DataMask::unmaskBitMatrix(BitMatrix& bits, size_t dimension) {
-  for (size_t y = 0; y < dimension; y++) {
-    for (size_t x = 0; x < dimension; x++) {
+namespace {
+  // Version 40
+  const int MAX_DIMENSION = 177;
+}
+
+void DataMask::buildPattern() {
+  pattern_ = new BitMatrix(MAX_DIMENSION, PATTERN_ROWS);
+  for (int y = 0; y < PATTERN_ROWS; y++) {
+    for (int x = 0; x < MAX_DIMENSION; x++) {
       // TODO: check why the coordinates have to be swapped
       if (isMasked(y, x)) {
-        bits.flip(x, y);
+        pattern_->set(x, y);
       }
     }
   }
 }
 
+void DataMask::unmaskBitMatrix(BitMatrix& bits, size_t dimension) {
+  if (dimension > (size_t)MAX_DIMENSION) {
+    throw IllegalArgumentException("dimension is larger than any version");
+  }
+  int words = (dimension + BitMatrix::bitsPerWord - 1) / BitMatrix::bitsPerWord;
+  // Keep the bits past the last column clear.
+  int lastMask = BitUtils::rangeMask(0, (dimension - 1) % BitMatrix::bitsPerWord);
+  for (size_t y = 0; y < dimension; y++) {
+    int* row = bits.getRowBits(y);
+    int const* mask = pattern_->getRowBits(y % PATTERN_ROWS);
+    for (int i = 0; i < words - 1; i++) {
+      row[i] ^= mask[i];
+    }
+    row[words - 1] ^= mask[words - 1] & lastMask;
+  }
+}
+
 /**
  * 000: mask bits for which (x + y) mod 2 == 0
  */
@@ -152,6 +176,13 @@ int DataMask::buildDataMasks() {
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask101()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask110()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask111()));
+  // Built once during static initialisation and only read afterwards, by
+  // any number of decoder threads.
+  for (size_t i = 0; i < DATA_MASKS.size(); i++) {
+    DATA_MASKS[i]->buildPattern();
+    DATA_MASKS[i]->markShared();
+    DATA_MASKS[i]->pattern_->markShared();
+  }
   return DATA_MASKS.size();
 }
 
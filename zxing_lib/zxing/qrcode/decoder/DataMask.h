@@ -33,6 +33,13 @@ class DataMask : public Counted {
 private:
   static std::vector<Ref<DataMask> > DATA_MASKS;
 
+  // The mask over the first PATTERN_ROWS rows of the largest symbol; every
+  // mask repeats itself after that many rows, so unmasking is a word-wise
+  // XOR of each row with one of these.
+  static const int PATTERN_ROWS = 12;
+  Ref<BitMatrix> pattern_;
+  void buildPattern();
+
 protected:
 
 public:
@@ -204,5 +204,6 @@ Ref<AlignmentPattern> AlignmentPatternFinder::find() {
     return center;
   }
 
-  throw zxing::ReaderException("Could not find alignment pattern");
+  // Could not find alignment pattern
+  return Ref<AlignmentPattern>();
 }
@@ -54,6 +54,7 @@ public:
   AlignmentPatternFinder(Ref<BitMatrix> image, int startX, int startY, int width, int height,
                          float moduleSize, Ref<ResultPointCallback>const& callback);
   ~AlignmentPatternFinder();
+  // Returns an empty Ref if no alignment pattern was found.
   Ref<AlignmentPattern> find();
   
 private:
@@ -102,13 +102,11 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
 
     // Kind of arbitrary -- expand search radius before giving up
     for (int i = 4; i <= 16; i <<= 1) {
-      try {
-        alignmentPattern = findAlignmentInRegion(moduleSize, estAlignmentX, estAlignmentY, (float)i);
+      alignmentPattern = findAlignmentInRegion(moduleSize, estAlignmentX, estAlignmentY, (float)i);
+      if (!alignmentPattern.empty()) {
         break;
-      } catch (zxing::ReaderException const& re) {
-        (void)re;
-        // try next round
       }
+      // try next round
     }
     if (alignmentPattern == 0) {
       // Try anyway
@@ -310,12 +308,13 @@ Ref<AlignmentPattern> Detector::findAlignmentInRegion(float overallEstModuleSize
   int alignmentAreaLeftX = max(0, estAlignmentX - allowance);
   int alignmentAreaRightX = min((int)(image_->getWidth() - 1), estAlignmentX + allowance);
   if (alignmentAreaRightX - alignmentAreaLeftX < overallEstModuleSize * 3) {
-    throw zxing::ReaderException("region too small to hold alignment pattern");
+    // region too small to hold alignment pattern
+    return Ref<AlignmentPattern>();
   }
   int alignmentAreaTopY = max(0, estAlignmentY - allowance);
   int alignmentAreaBottomY = min((int)(image_->getHeight() - 1), estAlignmentY + allowance);
   if (alignmentAreaBottomY - alignmentAreaTopY < overallEstModuleSize * 3) {
-    throw zxing::ReaderException("region too small to hold alignment pattern");
+    return Ref<AlignmentPattern>();
   }
 
   AlignmentPatternFinder alignmentFinder(image_, alignmentAreaLeftX, alignmentAreaTopY, alignmentAreaRightX
@@ -51,6 +51,7 @@ protected:
   float calculateModuleSizeOneWay(Ref<ResultPoint> pattern, Ref<ResultPoint> otherPattern);
   float sizeOfBlackWhiteBlackRunBothWays(int fromX, int fromY, int toX, int toY);
   float sizeOfBlackWhiteBlackRun(int fromX, int fromY, int toX, int toY);
+  // Returns an empty Ref when the region holds no alignment pattern.
   Ref<AlignmentPattern> findAlignmentInRegion(float overallEstModuleSize, int estAlignmentX, int estAlignmentY,
       float allowanceFactor);
   Ref<DetectorResult> processFinderPatternInfo(Ref<FinderPatternInfo> info);
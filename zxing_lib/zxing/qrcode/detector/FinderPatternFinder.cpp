@@ -23,6 +23,8 @@
 #include <zxing/qrcode/detector/FinderPatternFinder.h>
 #include <zxing/ReaderException.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/common/BitUtils.h>
+#include <zxing/oned/RunLengthRow.h>
 #if defined(__ICCARM__) || defined( __CC_ARM )  //
 #include <math.h>                               //
 #endif                                          //
@@ -42,6 +44,9 @@ using zxing::BitMatrix;
 using zxing::ResultPointCallback;
 using zxing::ResultPoint;
 using zxing::DecodeHints;
+using zxing::BitArray;
+using zxing::BitUtils;
+using zxing::oned::RunLengthRow;
 
 namespace {
 
@@ -77,6 +82,79 @@ public:
   }
 };
 
+// Returns how many pixels of line in a row have the colour value, walking
+// from x towards end, which is not included; right if end is past x, else
+// left. Works a word at a time, line being laid out as a BitMatrix row.
+int countRun(int const* line, int x, int end, bool value) {
+  unsigned int flip = value ? ~0u : 0u;
+  int pos = x;
+  if (end > x) {
+    while (pos < end) {
+      unsigned int differ = ((unsigned int)line[pos >> 5] ^ flip) >> (pos & 31);
+      if (differ != 0) {
+        pos += BitUtils::numberOfTrailingZeros(differ);
+        return (pos < end ? pos : end) - x;
+      }
+      pos = (pos | 31) + 1;
+    }
+    return end - x;
+  }
+  while (pos > end) {
+    unsigned int differ = ((unsigned int)line[pos >> 5] ^ flip) << (31 - (pos & 31));
+    if (differ != 0) {
+      pos -= BitUtils::numberOfLeadingZeros(differ);
+      return x - (pos > end ? pos : end);
+    }
+    pos = (pos & ~31) - 1;
+  }
+  return x - end;
+}
+
+// Measures the black/white/black/white/black runs of line that cross
+// pixel start into stateCount, as the cross checks need them: the runs on
+// either side of the center must not reach the ends of the line, and
+// the outer ones must stay within maxCount. Returns where the last run
+// ends, or -1 if there is no such pattern.
+int measureCross(int const* line, int size, int start, int maxCount, int* stateCount) {
+  // Start counting up from center
+  int i = start;
+  stateCount[2] = countRun(line, i, -1, true);
+  i -= stateCount[2];
+  if (i < 0) {
+    return -1;
+  }
+  stateCount[1] = countRun(line, i, -1, false);
+  i -= stateCount[1];
+  // If already too many modules in this state or ran off the edge:
+  if (i < 0 || stateCount[1] > maxCount) {
+    return -1;
+  }
+  stateCount[0] = countRun(line, i, -1, true);
+  if (stateCount[0] > maxCount) {
+    return -1;
+  }
+
+  // Now also count down from center
+  i = start + 1;
+  int count = countRun(line, i, size, true);
+  stateCount[2] += count;
+  i += count;
+  if (i == size) {
+    return -1;
+  }
+  stateCount[3] = countRun(line, i, size, false);
+  i += stateCount[3];
+  if (i == size || stateCount[3] >= maxCount) {
+    return -1;
+  }
+  stateCount[4] = countRun(line, i, size, true);
+  i += stateCount[4];
+  if (stateCount[4] >= maxCount) {
+    return -1;
+  }
+  return i;
+}
+
 }
 
 int FinderPatternFinder::CENTER_QUORUM = 2;
@@ -107,59 +185,10 @@ bool FinderPatternFinder::foundPatternCross(int* stateCount) {
 }
 
 float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int maxCount, int originalStateCountTotal) {
-
-  int maxI = image_->getHeight();
   int stateCount[5];
-  for (int i = 0; i < 5; i++)
-    stateCount[i] = 0;
-
-
-  // Start counting up from center
-  int i = startI;
-  while (i >= 0 && image_->get(centerJ, i)) {
-    stateCount[2]++;
-    i--;
-  }
-  if (i < 0) {
-    return nan();
-  }
-  while (i >= 0 && !image_->get(centerJ, i) && stateCount[1] <= maxCount) {
-    stateCount[1]++;
-    i--;
-  }
-  // If already too many modules in this state or ran off the edge:
-  if (i < 0 || stateCount[1] > maxCount) {
-    return nan();
-  }
-  while (i >= 0 && image_->get(centerJ, i) && stateCount[0] <= maxCount) {
-    stateCount[0]++;
-    i--;
-  }
-  if (stateCount[0] > maxCount) {
-    return nan();
-  }
-
-  // Now also count down from center
-  i = startI + 1;
-  while (i < maxI && image_->get(centerJ, i)) {
-    stateCount[2]++;
-    i++;
-  }
-  if (i == maxI) {
-    return nan();
-  }
-  while (i < maxI && !image_->get(centerJ, i) && stateCount[3] < maxCount) {
-    stateCount[3]++;
-    i++;
-  }
-  if (i == maxI || stateCount[3] >= maxCount) {
-    return nan();
-  }
-  while (i < maxI && image_->get(centerJ, i) && stateCount[4] < maxCount) {
-    stateCount[4]++;
-    i++;
-  }
-  if (stateCount[4] >= maxCount) {
+  int end = measureCross(getTransposedImage()->getRowBits(centerJ), image_->getHeight(), startI, maxCount,
+                         stateCount);
+  if (end < 0) {
     return nan();
   }
 
@@ -170,60 +199,14 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
     return nan();
   }
 
-  return foundPatternCross(stateCount) ? centerFromEnd(stateCount, i) : nan();
+  return foundPatternCross(stateCount) ? centerFromEnd(stateCount, end) : nan();
 }
 
 float FinderPatternFinder::crossCheckHorizontal(size_t startJ, size_t centerI, int maxCount,
     int originalStateCountTotal) {
-
-  int maxJ = image_->getWidth();
   int stateCount[5];
-  for (int i = 0; i < 5; i++)
-    stateCount[i] = 0;
-
-  int j = startJ;
-  while (j >= 0 && image_->get(j, centerI)) {
-    stateCount[2]++;
-    j--;
-  }
-  if (j < 0) {
-    return nan();
-  }
-  while (j >= 0 && !image_->get(j, centerI) && stateCount[1] <= maxCount) {
-    stateCount[1]++;
-    j--;
-  }
-  if (j < 0 || stateCount[1] > maxCount) {
-    return nan();
-  }
-  while (j >= 0 && image_->get(j, centerI) && stateCount[0] <= maxCount) {
-    stateCount[0]++;
-    j--;
-  }
-  if (stateCount[0] > maxCount) {
-    return nan();
-  }
-
-  j = startJ + 1;
-  while (j < maxJ && image_->get(j, centerI)) {
-    stateCount[2]++;
-    j++;
-  }
-  if (j == maxJ) {
-    return nan();
-  }
-  while (j < maxJ && !image_->get(j, centerI) && stateCount[3] < maxCount) {
-    stateCount[3]++;
-    j++;
-  }
-  if (j == maxJ || stateCount[3] >= maxCount) {
-    return nan();
-  }
-  while (j < maxJ && image_->get(j, centerI) && stateCount[4] < maxCount) {
-    stateCount[4]++;
-    j++;
-  }
-  if (stateCount[4] >= maxCount) {
+  int end = measureCross(image_->getRowBits(centerI), image_->getWidth(), startJ, maxCount, stateCount);
+  if (end < 0) {
     return nan();
   }
 
@@ -234,7 +217,7 @@ float FinderPatternFinder::crossCheckHorizontal(size_t startJ, size_t centerI, i
     return nan();
   }
 
-  return foundPatternCross(stateCount) ? centerFromEnd(stateCount, j) : nan();
+  return foundPatternCross(stateCount) ? centerFromEnd(stateCount, end) : nan();
 }
 
 bool FinderPatternFinder::handlePossibleCenter(int* stateCount, size_t i, size_t j) {
@@ -428,7 +411,7 @@ float FinderPatternFinder::distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2) {
 
 FinderPatternFinder::FinderPatternFinder(Ref<BitMatrix> image,
                                            Ref<ResultPointCallback>const& callback) :
-    image_(image), possibleCenters_(), hasSkipped_(false), callback_(callback) {
+    image_(image), transposed_(), possibleCenters_(), hasSkipped_(false), callback_(callback) {
 }
 
 Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
@@ -439,7 +422,7 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
 
 
   // We are looking for black/white/black/white/black modules in
-  // 1:1:3:1:1 ratio; this tracks the number of such modules seen so far
+  // 1:1:3:1:1 ratio; this holds the widths of five consecutive runs
 
   // As this is used often, we use an integer array instead of vector
   int stateCount[5];
@@ -458,91 +441,60 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
 
   // This is slightly faster than using the Ref. Efficiency is important here
   BitMatrix& matrix = *image_;
+  Ref<BitArray> row;
+  RunLengthRow runs;
 
   for (size_t i = iSkip - 1; i < maxI && !done; i += iSkip) {
     // Get a row of black/white values
-
-    stateCount[0] = 0;
-    stateCount[1] = 0;
-    stateCount[2] = 0;
-    stateCount[3] = 0;
-    stateCount[4] = 0;
-    int currentState = 0;
-    for (size_t j = 0; j < maxJ; j++) {
-      if (matrix.get(j, i)) {
-        // Black pixel
-        if ((currentState & 1) == 1) { // Counting white pixels
-          currentState++;
-        }
-        stateCount[currentState]++;
-      } else { // White pixel
-        if ((currentState & 1) == 0) { // Counting black pixels
-          if (currentState == 4) { // A winner?
-            if (foundPatternCross(stateCount)) { // Yes
-              bool confirmed = handlePossibleCenter(stateCount, i, j);
-              if (confirmed) {
-                // Start examining every other line. Checking each line turned out to be too
-                // expensive and didn't improve performance.
-                iSkip = 2;
-                if (hasSkipped_) {
-                  done = haveMultiplyConfirmedCenters();
-                } else {
-                  int rowSkip = findRowSkip();
-                  if (rowSkip > stateCount[2]) {
-                    // Skip rows between row of lower confirmed center
-                    // and top of presumed third confirmed center
-                    // but back up a bit to get a full chance of detecting
-                    // it, entire width of center of finder pattern
-
-                    // Skip by rowSkip, but back off by stateCount[2] (size
-                    // of last center of pattern we saw) to be conservative,
-                    // and also back off by iSkip which is about to be
-                    // re-added
-                    i += rowSkip - stateCount[2] - iSkip;
-                    j = maxJ - 1;
-                  }
-                }
-              } else {
-                stateCount[0] = stateCount[2];
-                stateCount[1] = stateCount[3];
-                stateCount[2] = stateCount[4];
-                stateCount[3] = 1;
-                stateCount[4] = 0;
-                currentState = 3;
-                continue;
-              }
-              // Clear state to start looking again
-              currentState = 0;
-              stateCount[0] = 0;
-              stateCount[1] = 0;
-              stateCount[2] = 0;
-              stateCount[3] = 0;
-              stateCount[4] = 0;
-            } else { // No, shift counts back by two
-              stateCount[0] = stateCount[2];
-              stateCount[1] = stateCount[3];
-              stateCount[2] = stateCount[4];
-              stateCount[3] = 1;
-              stateCount[4] = 0;
-              currentState = 3;
-            }
-          } else {
-            stateCount[++currentState]++;
-          }
-        } else { // Counting white pixels
-          stateCount[currentState]++;
-        }
+    row = matrix.getRow(i, row);
+    runs.reset(row);
+
+    // The bars are the odd runs. Try every five runs that end in a bar,
+    // right after that bar, for black/white/black/white/black.
+    int runCount = runs.getRunCount();
+    for (int run = 5; run < runCount; run += 2) {
+      for (int k = 0; k < 5; k++) {
+        stateCount[k] = runs[run - 4 + k];
       }
-    }
-    if (foundPatternCross(stateCount)) {
-      bool confirmed = handlePossibleCenter(stateCount, i, maxJ);
-      if (confirmed) {
+      if (!foundPatternCross(stateCount)) {
+        continue;
+      }
+      size_t j = runs.getRunEnd(run);
+      if (!handlePossibleCenter(stateCount, i, j)) {
+        continue;
+      }
+      if (j == maxJ) {
+        // The pattern ends the row
         iSkip = stateCount[0];
         if (hasSkipped_) {
           // Found a third one
           done = haveMultiplyConfirmedCenters();
         }
+        break;
+      }
+      // Start examining every other line. Checking each line turned out to be too
+      // expensive and didn't improve performance.
+      iSkip = 2;
+      if (hasSkipped_) {
+        done = haveMultiplyConfirmedCenters();
+      } else {
+        int rowSkip = findRowSkip();
+        if (rowSkip > stateCount[2]) {
+          // Skip rows between row of lower confirmed center
+          // and top of presumed third confirmed center
+          // but back up a bit to get a full chance of detecting
+          // it, entire width of center of finder pattern
+
+          // Skip by rowSkip, but back off by stateCount[2] (size
+          // of last center of pattern we saw) to be conservative,
+          // and also back off by iSkip which is about to be
+          // re-added
+          i += rowSkip - stateCount[2] - iSkip;
+          break;
+        }
       }
+      // Start looking again after the space that follows the pattern
+      run += 4;
     }
   }
 
@@ -557,6 +509,13 @@ Ref<BitMatrix> FinderPatternFinder::getImage() {
   return image_;
 }
 
+Ref<BitMatrix> FinderPatternFinder::getTransposedImage() {
+  if (transposed_.empty()) {
+    transposed_ = image_->transpose();
+  }
+  return transposed_;
+}
+
 vector<Ref<FinderPattern> >& FinderPatternFinder::getPossibleCenters() {
   return possibleCenters_;
 }
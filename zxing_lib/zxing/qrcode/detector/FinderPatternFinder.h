@@ -43,6 +43,9 @@ protected:
   static int MAX_MODULES;
 
   Ref<BitMatrix> image_;
+  // image_ transposed, so the vertical cross checks can read columns as
+  // rows. Made on the first check.
+  Ref<BitMatrix> transposed_;
   std::vector<Ref<FinderPattern> > possibleCenters_;
   bool hasSkipped_;
 
@@ -63,6 +66,7 @@ protected:
   static std::vector<Ref<FinderPattern> > orderBestPatterns(std::vector<Ref<FinderPattern> > patterns);
 
   Ref<BitMatrix> getImage();
+  Ref<BitMatrix> getTransposedImage();
   std::vector<Ref<FinderPattern> >& getPossibleCenters();
 
 public:
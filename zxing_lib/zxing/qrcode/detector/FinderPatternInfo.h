@@ -22,13 +22,14 @@
 
 #include <zxing/qrcode/detector/FinderPattern.h>
 #include <zxing/common/Counted.h>
+#include <zxing/common/Arena.h>
 #include <zxing/common/Array.h>
 #include <vector>
 
 namespace zxing {
 namespace qrcode {
 
-class FinderPatternInfo : public Counted {
+class FinderPatternInfo : public Counted, public ArenaAllocated {
 private:
   Ref<FinderPattern> bottomLeft_;
   Ref<FinderPattern> topLeft_;
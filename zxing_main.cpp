@@ -4,18 +4,19 @@
 #include "mbed.h"
 #include "rtos.h"
 #include "DisplayBace.h"
-#include "ImageReaderSource.h"
+#include "FrameDecoder.h"
 #include "DisplayApp.h"
 #include "AsciiFont.h"
 
 #define VIDEO_CVBS             (0)                 /* Analog  Video Signal */
 #define VIDEO_CMOS_CAMERA      (1)                 /* Digital Video Signal */
+#define VIDEO_YCBCR422         (0)
 #define VIDEO_RGB888           (1)
 
 /**** User Selection *********/
 /** Camera setting **/
 #define VIDEO_INPUT_METHOD     (VIDEO_CMOS_CAMERA) /* Select  VIDEO_CVBS or VIDEO_CMOS_CAMERA                       */
-#define VIDEO_INPUT_FORMAT     (VIDEO_RGB888)      /* Select  VIDEO_RGB888                                          */
+#define VIDEO_INPUT_FORMAT     (VIDEO_RGB888)      /* Select  VIDEO_YCBCR422 or VIDEO_RGB888                        */
 #define USE_VIDEO_CH           (0)                 /* Select  0 or 1            If selecting VIDEO_CMOS_CAMERA, should be 0.)               */
 #define VIDEO_PAL              (0)                 /* Select  0(NTSC) or 1(PAL) If selecting VIDEO_CVBS, this parameter is not referenced.) */
 /** LCD setting **/
@@ -52,9 +53,18 @@
 #endif
 
 /* Video input */
-#define VIDEO_FORMAT           (DisplayBase::VIDEO_FORMAT_RGB888)
-#define GRAPHICS_FORMAT        (DisplayBase::GRAPHICS_FORMAT_RGB888)
-#define WR_RD_WRSWA            (DisplayBase::WR_RD_WRSWA_32BIT)
+#if VIDEO_INPUT_FORMAT == VIDEO_YCBCR422
+  /* The decoder reads only the Y bytes, a quarter of the RGB888 frame traffic. */
+  #define VIDEO_FORMAT           (DisplayBase::VIDEO_FORMAT_YCBCR422)
+  #define GRAPHICS_FORMAT        (DisplayBase::GRAPHICS_FORMAT_YCBCR422)
+  #define WR_RD_WRSWA            (DisplayBase::WR_RD_WRSWA_32_16BIT)
+  #define DECODE_PIXEL_FORMAT    (ImageReaderSource::YUYV)
+#else
+  #define VIDEO_FORMAT           (DisplayBase::VIDEO_FORMAT_RGB888)
+  #define GRAPHICS_FORMAT        (DisplayBase::GRAPHICS_FORMAT_RGB888)
+  #define WR_RD_WRSWA            (DisplayBase::WR_RD_WRSWA_32BIT)
+  #define DECODE_PIXEL_FORMAT    (ImageReaderSource::RGBA8888)
+#endif
 
 /* The size of the video input */
 #if ((LCD_ONOFF) && (LCD_TYPE == 0))
@@ -69,7 +79,11 @@
     in accordance with the frame buffer burst transfer mode. */
 /* FRAME BUFFER Parameter GRAPHICS_LAYER_0 */
 #define FRAME_BUFFER_NUM              (2u)
+#if VIDEO_INPUT_FORMAT == VIDEO_YCBCR422
+#define FRAME_BUFFER_BYTE_PER_PIXEL   (2u)
+#else
 #define FRAME_BUFFER_BYTE_PER_PIXEL   (4u)
+#endif
 #define FRAME_BUFFER_STRIDE           (((VIDEO_PIXEL_HW * FRAME_BUFFER_BYTE_PER_PIXEL) + 31u) & ~31u)
 
 #if LCD_ONOFF
@@ -103,6 +117,7 @@ static int write_buff_num = 0;
 static bool graphics_init_end = false;
 static int decode_wait_time = 0;
 static void (*p_callback_func)(char * addr, int size);
+static FrameDecoder * frame_decoder = NULL;
 
 /****** cache control ******/
 static void dcache_clean(void * p_buf, uint32_t size) {
@@ -354,6 +369,8 @@ void zxing_init(void (*pfunc)(char * addr, int size)) {
     lcd_cntrst.write(1.0);
 #endif
     p_callback_func = pfunc;
+    /* Decoder buffers are sized for the video input once and reused for every frame */
+    frame_decoder = new FrameDecoder(VIDEO_PIXEL_HW, VIDEO_PIXEL_VW, FRAME_BUFFER_STRIDE, DECODE_PIXEL_FORMAT);
     decode_timer.reset();
     decode_timer.start();
 }
@@ -384,7 +401,7 @@ int zxing_loop() {
     /* Decode barcode image */
     if (decode_timer.read_ms() >= decode_wait_time) {
         decode_timer.reset();
-        decode_result = ex_decode(decode_buffer, (FRAME_BUFFER_STRIDE * VIDEO_PIXEL_VW), VIDEO_PIXEL_HW, VIDEO_PIXEL_VW, &results);
+        decode_result = frame_decoder->decode(decode_buffer, &results);
         if (decode_result == 0) {
             char ** decode_str;
             int     size;
@@ -428,7 +445,9 @@ int zxing_loop() {
             decode_wait_time = 10;
         }
     }
+#if VIDEO_INPUT_FORMAT == VIDEO_RGB888
     display_app.SendRgb888(decode_buffer, VIDEO_PIXEL_HW, VIDEO_PIXEL_VW);
+#endif
 
     return decode_result;
 }